@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+/* Set to true before including any container header to enable allocation tracking.
+When false, every tracking hook compiles away to nothing. */
+#ifndef TRACK_CONTAINER_ALLOCATIONS
+#define TRACK_CONTAINER_ALLOCATIONS false
+#endif
+
+/* Allocation counters for a single container type on a single thread. */
+struct alloc_counters
+{
+	/* Number of heap allocations performed. */
+	size_t allocations;
+
+	/* Total number of bytes requested by all heap allocations. */
+	size_t bytes;
+
+	/* Number of allocations that replaced an existing buffer (growth, reserve). */
+	size_t reallocations;
+
+	/* Number of strings constructed that fit within the sso buffer. */
+	size_t ssoHits;
+
+	/* Number of strings constructed that were too long for the sso buffer, and needed heap data. A spill only counts as one of
+	the allocations when the string calls new itself. Buffers reused from string_buffer_pool are not allocations. */
+	size_t heapSpills;
+
+	/* Number of strings constructed that pointed to the const data segment instead of copying. */
+	size_t constSegmentHits;
+
+	constexpr void AddAllocation(size_t allocatedBytes) {
+		allocations++;
+		bytes += allocatedBytes;
+	}
+
+	constexpr void AddReallocation(size_t allocatedBytes) {
+		AddAllocation(allocatedBytes);
+		reallocations++;
+	}
+};
+
+/* Whether allocations of a container type are tracked. Follows TRACK_CONTAINER_ALLOCATIONS, and can be specialized as std::true_type
+to track a single container type without enabling tracking for the whole build. The specialization must be visible everywhere the type is used,
+so specialize it only for types used in a single translation unit, such as a test's own element type. */
+template<typename Container>
+struct alloc_tracking_enabled : std::bool_constant<TRACK_CONTAINER_ALLOCATIONS> {};
+
+/* Per-type, per-thread allocation tracking. Containers call the Record functions whenever they touch the heap.
+Recording is skipped during constant evaluation, and compiles to nothing if alloc_tracking_enabled<Container> is false.
+@param Container: The container type being tracked, such as darray<int> or string. */
+template<typename Container>
+struct alloc_tracker
+{
+	/* @return The allocation counters of Container for the calling thread. */
+	[[nodiscard]] static const alloc_counters& Get() {
+		return Counters();
+	}
+
+	/* Sets all of the calling thread's counters for Container back to 0. */
+	static void Reset() {
+		Counters() = alloc_counters{};
+	}
+
+	/* Records a fresh heap allocation of a number of bytes. */
+	constexpr static void RecordAllocation(size_t bytes) {
+		if constexpr (alloc_tracking_enabled<Container>::value) {
+			if (!std::is_constant_evaluated()) {
+				Counters().AddAllocation(bytes);
+			}
+		}
+	}
+
+	/* Records a heap allocation of a number of bytes that replaces an already existing buffer. */
+	constexpr static void RecordReallocation(size_t bytes) {
+		if constexpr (alloc_tracking_enabled<Container>::value) {
+			if (!std::is_constant_evaluated()) {
+				Counters().AddReallocation(bytes);
+			}
+		}
+	}
+
+	/* Records a string fitting within the sso buffer. */
+	constexpr static void RecordSSOHit() {
+		if constexpr (alloc_tracking_enabled<Container>::value) {
+			if (!std::is_constant_evaluated()) {
+				Counters().ssoHits++;
+			}
+		}
+	}
+
+	/* Records a string spilling out of the sso buffer. Any heap allocation it needs is recorded separately with RecordAllocation(). */
+	constexpr static void RecordHeapSpill() {
+		if constexpr (alloc_tracking_enabled<Container>::value) {
+			if (!std::is_constant_evaluated()) {
+				Counters().heapSpills++;
+			}
+		}
+	}
+
+	/* Records a string pointing to the const data segment rather than copying. */
+	constexpr static void RecordConstSegmentHit() {
+		if constexpr (alloc_tracking_enabled<Container>::value) {
+			if (!std::is_constant_evaluated()) {
+				Counters().constSegmentHits++;
+			}
+		}
+	}
+
+private:
+
+	static alloc_counters& Counters() {
+		thread_local alloc_counters counters{};
+		return counters;
+	}
+
+};
@@ -0,0 +1,152 @@
+#include "alloc_tracking.h"
+#include "../types/array/dynamic_array.h"
+#include "../types/string/string.h"
+
+#define TEST_TYPES "Allocation Tracking"
+#include <testframework/unit_test_compile_time.h>
+#include <testframework/unit_test_runtime.h>
+
+namespace AllocTrackingUnitTests
+{
+	/* Only used in this file, so tracking can be enabled for darray<tracked_element> without changing darray for any other translation unit. */
+	struct tracked_element
+	{
+		int value;
+	};
+
+	/* No other translation unit uses a 96 byte sso buffer. */
+	typedef buffer_string<96> tracked_string;
+}
+
+template<>
+struct alloc_tracking_enabled<darray<AllocTrackingUnitTests::tracked_element>> : std::true_type {};
+
+template<>
+struct alloc_tracking_enabled<AllocTrackingUnitTests::tracked_string> : std::true_type {};
+
+namespace AllocTrackingUnitTests
+{
+
+#pragma region Counters
+
+	constexpr bool CountAllocation() {
+		alloc_counters counters{};
+		counters.AddAllocation(64);
+		return counters.allocations == 1 && counters.bytes == 64 && counters.reallocations == 0 && counters.heapSpills == 0;
+	}
+	TEST_ASSERT(CountAllocation(), "Allocation does not count a single allocation and its bytes");
+
+	constexpr bool CountReallocation() {
+		alloc_counters counters{};
+		counters.AddAllocation(16);
+		counters.AddReallocation(32);
+		return counters.allocations == 2 && counters.bytes == 48 && counters.reallocations == 1;
+	}
+	TEST_ASSERT(CountReallocation(), "Reallocation is not counted as both an allocation and a reallocation");
+
+	static_assert(alloc_tracking_enabled<darray<tracked_element>>::value && alloc_tracking_enabled<tracked_string>::value,
+		"Allocation tracking is not enabled for the tracked test types");
+
+	/* Recording is skipped during constant evaluation, so tracked containers stay constexpr valid. */
+	constexpr bool TrackedArrayConstexpr() {
+		darray<tracked_element> arr;
+		arr.Reserve(4);
+		for (int i = 0; i < 10; i++) {
+			arr.Add(tracked_element{ i });
+		}
+		tracked_string str = "a string that is long enough to spill out of the 96 byte sso buffer of the tracked string type ok";
+		return arr.Size() == 10 && arr[9].value == 9 && !str.IsSSO();
+	}
+	TEST_ASSERT(TrackedArrayConstexpr(), "Tracked containers are not constexpr valid");
+
+#pragma endregion
+
+#pragma region Array_Hooks
+
+	bool ArrayReserveAndGrow() {
+		typedef alloc_tracker<darray<tracked_element>> tracker;
+		tracker::Reset();
+		darray<tracked_element> arr;
+		const bool constructed = tracker::Get().allocations == 1 && tracker::Get().reallocations == 0;
+		arr.Reserve(4);
+		for (int i = 0; i < 10; i++) {
+			arr.Add(tracked_element{ i });
+		}
+		// Reserve(4), then growing to 8 and 16 while adding.
+		const alloc_counters& counters = tracker::Get();
+		return constructed && counters.allocations == 4 && counters.reallocations == 3
+			&& counters.bytes == sizeof(tracked_element) * (darray<tracked_element>::DEFAULT_CAPACITY + 4 + 8 + 16);
+	}
+	RUNTIME_TEST_ASSERT(ArrayReserveAndGrow(), "Array Reserve() and Add() past capacity do not record their reallocations");
+
+	bool ArrayCopy() {
+		typedef alloc_tracker<darray<tracked_element>> tracker;
+		darray<tracked_element> arr;
+		arr.Add(tracked_element{ 1 });
+		tracker::Reset();
+		darray<tracked_element> copy = arr;
+		darray<tracked_element> moved = std::move(copy);
+		return tracker::Get().allocations == 1 && tracker::Get().reallocations == 0 && moved.Size() == 1;
+	}
+	RUNTIME_TEST_ASSERT(ArrayCopy(), "Array copy does not record exactly one allocation, or move records one");
+
+#pragma endregion
+
+#pragma region String_Hooks
+
+	bool StringSSOHit() {
+		typedef alloc_tracker<tracked_string> tracker;
+		tracker::Reset();
+		char chars[] = "short";
+		tracked_string str = chars;
+		return tracker::Get().ssoHits == 1 && tracker::Get().heapSpills == 0 && str.IsSSO();
+	}
+	RUNTIME_TEST_ASSERT(StringSSOHit(), "String construction within the sso buffer does not record an sso hit");
+
+	bool StringHeapSpill() {
+		typedef alloc_tracker<tracked_string> tracker;
+		tracker::Reset();
+		// On the stack, so it is never in the const data segment.
+		char chars[] = "a string that is long enough to spill out of the 96 byte sso buffer of the tracked string type ok";
+		tracked_string str = chars;
+		tracked_string copy = str;
+		return tracker::Get().heapSpills == 2 && tracker::Get().ssoHits == 0 && !copy.IsSSO();
+	}
+	RUNTIME_TEST_ASSERT(StringHeapSpill(), "String construction and copy past the sso buffer do not record heap spills");
+
+	/* Pooled buffers may be reused rather than allocated, so only the string's own new calls count as its allocations. */
+	bool StringHeapSpillAllocations() {
+		typedef alloc_tracker<tracked_string> tracker;
+		char pooledChars[] = "a string that is long enough to spill out of the 96 byte sso buffer of the tracked string type ok";
+		char largeChars[string_buffer_pool::LARGEST_CLASS + 1];
+		for (size_t i = 0; i < string_buffer_pool::LARGEST_CLASS; i++) {
+			largeChars[i] = 'a';
+		}
+		largeChars[string_buffer_pool::LARGEST_CLASS] = '\0';
+
+		tracker::Reset();
+		tracked_string pooled = pooledChars;
+		const bool pooledCounted = STRING_BUFFER_POOL
+			? tracker::Get().allocations == 0
+			: tracker::Get().allocations == 1 && tracker::Get().bytes == pooled.Capacity();
+
+		tracker::Reset();
+		tracked_string large = largeChars;
+		return pooledCounted && tracker::Get().heapSpills == 1 && tracker::Get().allocations == 1
+			&& tracker::Get().bytes == string_buffer_pool::LARGEST_CLASS + 1 && large.Capacity() == string_buffer_pool::LARGEST_CLASS + 1;
+	}
+	RUNTIME_TEST_ASSERT(StringHeapSpillAllocations(), "String heap spill records an allocation for a pooled buffer, or misses one made with new");
+
+	bool StringConstSegmentCopy() {
+		typedef alloc_tracker<tracked_string> tracker;
+		static const char symbol[] = "interned";
+		const tracked_string interned = tracked_string::FromInterned(symbol, 8);
+		tracker::Reset();
+		tracked_string copy = interned;
+		return tracker::Get().constSegmentHits == 1 && tracker::Get().heapSpills == 0 && copy.CStr() == symbol;
+	}
+	RUNTIME_TEST_ASSERT(StringConstSegmentCopy(), "Copying a const segment string does not record a const segment hit");
+
+#pragma endregion
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+/* Index checks are removed entirely. */
+#define CONTAINER_CHECKS_OFF 0
+
+/* Index checks use assert, so they are also removed when NDEBUG is defined. */
+#define CONTAINER_CHECKS_ASSERT 1
+
+/* Index checks throw std::out_of_range. */
+#define CONTAINER_CHECKS_THROW 2
+
+/* Set to one of the policies above before including any container header to choose how element access is checked.
+Defaults to CONTAINER_CHECKS_OFF when NDEBUG is defined, and CONTAINER_CHECKS_THROW otherwise. */
+#ifndef CONTAINER_CHECK_POLICY
+#ifdef NDEBUG
+#define CONTAINER_CHECK_POLICY CONTAINER_CHECKS_OFF
+#else
+#define CONTAINER_CHECK_POLICY CONTAINER_CHECKS_THROW
+#endif
+#endif
+
+/* Library wide element access checking, following CONTAINER_CHECK_POLICY. Used by At(), operator [] and similar accessors of every container.
+Checks always run during constant evaluation regardless of the policy, where a failed check makes the expression non constant,
+so an out of bounds access in a TEST_ASSERT test fails to compile. */
+struct bounds_check
+{
+	/* Checks that index is less than size.
+	@param message: Thrown as std::out_of_range, or asserted, when the check fails. */
+	constexpr static void Index(size_t index, size_t size, const char* message) {
+		if (std::is_constant_evaluated()) {
+			if (index >= size) {
+				throw std::out_of_range(message);
+			}
+			return;
+		}
+#if CONTAINER_CHECK_POLICY == CONTAINER_CHECKS_THROW
+		if (index >= size) {
+			throw std::out_of_range(message);
+		}
+#elif CONTAINER_CHECK_POLICY == CONTAINER_CHECKS_ASSERT
+		assert(index < size && message);
+#else
+		(void)index;
+		(void)size;
+		(void)message;
+#endif
+	}
+};
@@ -1,10 +1,10 @@
 #include "types/string/string.h"
 #include "types/array/dynamic_array.h"
 #include "types/bitset/bitset.h"
+#include "testframework/unit_test_runtime.h"
 #include <iostream>
 #include <vector>
 
 int main() {
-
-
+	return runtime_unit_tests::RunAll() == 0 ? 0 : 1;
 }
\ No newline at end of file
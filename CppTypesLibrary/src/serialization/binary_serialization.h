@@ -0,0 +1,368 @@
+#pragma once
+
+#include "../types/array/dynamic_array.h"
+#include "../types/string/string.h"
+#include "../types/bitset/bitset.h"
+#include "../types/bitset/bloom_filter.h"
+#include <array>
+#include <bit>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+/* Binary format layout:
+A 32 byte file header of the magic "CTLB", the format version, and the byte order of the writer. Every record after is a 16 byte record header
+(element count, element size, record type), followed by the payload starting on a 32 byte boundary. Payloads are aligned to _STRING_SSO_ALIGNMENT,
+so arrays and strings can be viewed directly from the input buffer, or from a mapped file, without copying. */
+
+/* Alignment of every record payload within a serialized buffer. */
+constexpr size_t _BINARY_ALIGNMENT = _STRING_SSO_ALIGNMENT;
+
+/* Current version of the binary format. Readers reject buffers written by a newer version. */
+constexpr unsigned int _BINARY_FORMAT_VERSION = 1;
+
+constexpr size_t _BINARY_FILE_HEADER_SIZE = 32;
+
+constexpr size_t _BINARY_RECORD_HEADER_SIZE = 16;
+
+/* Type of each record in a serialized buffer. */
+enum class binary_record : unsigned int
+{
+	Array = 1,
+	String = 2,
+	Bitset = 3,
+	BloomFilter = 4
+};
+
+/* Serializes darrays, strings, bitsets, and bloom filters into a single contiguous, 32 byte aligned buffer.
+Trivially copyable array elements are written with a single bulk copy. */
+struct binary_writer
+{
+private:
+
+	unsigned char* bytes;
+	size_t size;
+	size_t capacity;
+
+	constexpr static unsigned char* AllocateBytes(size_t count) {
+		if (std::is_constant_evaluated()) {
+			return new unsigned char[count];
+		}
+		return new (std::align_val_t(_BINARY_ALIGNMENT)) unsigned char[count];
+	}
+
+	constexpr static void FreeBytes(unsigned char* ptr) {
+		if (std::is_constant_evaluated()) {
+			delete[] ptr;
+			return;
+		}
+		::operator delete[](ptr, std::align_val_t(_BINARY_ALIGNMENT));
+	}
+
+	/* Ensures there is room for count more bytes, at least doubling the capacity if it has to grow. */
+	constexpr void EnsureSpace(size_t count) {
+		if (size + count <= capacity) return;
+
+		size_t newCapacity = capacity * 2;
+		if (newCapacity < size + count) {
+			newCapacity = size + count;
+		}
+		unsigned char* newBytes = AllocateBytes(newCapacity);
+		std::copy(bytes, bytes + size, newBytes);
+		FreeBytes(bytes);
+		bytes = newBytes;
+		capacity = newCapacity;
+	}
+
+	constexpr void WriteZeros(size_t count) {
+		EnsureSpace(count);
+		for (size_t i = 0; i < count; i++) {
+			bytes[size + i] = 0;
+		}
+		size += count;
+	}
+
+	/* Writes an integer as little endian, regardless of the byte order of this machine. */
+	constexpr void WriteInteger(unsigned long long num, size_t byteCount) {
+		EnsureSpace(byteCount);
+		for (size_t i = 0; i < byteCount; i++) {
+			bytes[size + i] = (unsigned char)(num >> (i * 8));
+		}
+		size += byteCount;
+	}
+
+	/* Pads so that the record header ends, and the payload begins, on a 32 byte boundary. */
+	constexpr void WriteRecordHeader(binary_record type, unsigned long long count, unsigned int elementSize) {
+		const size_t headerEnd = size + _BINARY_RECORD_HEADER_SIZE;
+		const size_t padding = (_BINARY_ALIGNMENT - headerEnd % _BINARY_ALIGNMENT) % _BINARY_ALIGNMENT;
+		WriteZeros(padding);
+		WriteInteger(count, 8);
+		WriteInteger(elementSize, 4);
+		WriteInteger((unsigned int)type, 4);
+	}
+
+	/* Writes raw elements. Uses a single memcpy at runtime. */
+	template<typename T>
+	constexpr void WriteElements(const T* elements, size_t count) {
+		const size_t byteCount = count * sizeof(T);
+		EnsureSpace(byteCount);
+		if (std::is_constant_evaluated()) {
+			for (size_t i = 0; i < count; i++) {
+				const std::array<unsigned char, sizeof(T)> elementBytes = std::bit_cast<std::array<unsigned char, sizeof(T)>>(elements[i]);
+				std::copy(elementBytes.begin(), elementBytes.end(), bytes + size + i * sizeof(T));
+			}
+		}
+		else if (byteCount > 0) {
+			std::memcpy(bytes + size, elements, byteCount);
+		}
+		size += byteCount;
+	}
+
+public:
+
+	/* Writes the file header. */
+	constexpr binary_writer()
+		: bytes(nullptr), size(0), capacity(0)
+	{
+		bytes = AllocateBytes(256);
+		capacity = 256;
+		const char magic[4] = { 'C', 'T', 'L', 'B' };
+		for (size_t i = 0; i < 4; i++) {
+			WriteInteger((unsigned char)magic[i], 1);
+		}
+		WriteInteger(_BINARY_FORMAT_VERSION, 4);
+		WriteInteger(std::endian::native == std::endian::little ? 0 : 1, 1);
+		WriteZeros(_BINARY_FILE_HEADER_SIZE - size);
+	}
+
+	binary_writer(const binary_writer&) = delete;
+
+	binary_writer& operator = (const binary_writer&) = delete;
+
+	constexpr ~binary_writer() {
+		FreeBytes(bytes);
+	}
+
+	/* @return Number of bytes written, including the file header. */
+	[[nodiscard]] constexpr size_t Size() const { return size; }
+
+	/* @return The serialized bytes. Aligned to 32 bytes at runtime. */
+	[[nodiscard]] constexpr const unsigned char* Data() const { return bytes; }
+
+	/* Writes an array of trivially copyable elements as a single bulk copy. */
+	template<typename T>
+	constexpr void Write(const darray<T>& arr) {
+		static_assert(std::is_trivially_copyable_v<T>, "Only arrays of trivially copyable elements can be serialized");
+		WriteRecordHeader(binary_record::Array, arr.Size(), sizeof(T));
+		WriteElements(arr.Data(), arr.Size());
+	}
+
+	/* Writes the characters of a string, including the null terminator so the characters can be viewed as a const char*. */
+	template<size_t BUFFER_SIZE>
+	constexpr void Write(const buffer_string<BUFFER_SIZE>& str) {
+		WriteRecordHeader(binary_record::String, str.Len(), 1);
+		WriteElements(str.CStr(), str.Len() + 1);
+	}
+
+	/* Writes the bits of a bitset. */
+	template<size_t bitCount>
+	constexpr void Write(const bitset<bitCount>& bits) {
+		WriteRecordHeader(binary_record::Bitset, bitCount, sizeof(bits.bits));
+		WriteInteger((unsigned long long)bits.bits, 8);
+	}
+
+	/* Writes the blocks of a bloom filter as a single bulk copy. */
+	constexpr void Write(const blocked_bloom_filter& filter) {
+		const darray<bloom_block>& blocks = filter.Blocks();
+		WriteRecordHeader(binary_record::BloomFilter, blocks.Size(), sizeof(bloom_block));
+		WriteElements(blocks.Data(), blocks.Size());
+	}
+
+};
+
+/* Reads darrays, strings, bitsets, and bloom filters from a buffer written by binary_writer, in the order they were written.
+Throws std::runtime_error if the buffer is not valid, is truncated, or a record doesn't match the requested type.
+The View functions return views pointing directly into the buffer without copying, so the buffer must outlive them. */
+struct binary_reader
+{
+private:
+
+	const unsigned char* bytes;
+	size_t size;
+	size_t offset;
+
+	/* Throws if there are less than count elements of elementSize bytes left in the buffer. */
+	constexpr void Require(unsigned long long count, size_t elementSize = 1) const {
+		if (offset > size || count > (size - offset) / elementSize) {
+			throw std::runtime_error("Binary reader buffer is truncated!");
+		}
+	}
+
+	constexpr unsigned long long ReadInteger(size_t byteCount) {
+		Require(byteCount);
+		unsigned long long num = 0;
+		for (size_t i = 0; i < byteCount; i++) {
+			num |= (unsigned long long)bytes[offset + i] << (i * 8);
+		}
+		offset += byteCount;
+		return num;
+	}
+
+	/* Reads a record header, validating its type and element size.
+	@return The element count of the record. The offset is left at the start of the payload. */
+	constexpr unsigned long long ReadRecordHeader(binary_record type, unsigned int elementSize) {
+		const size_t headerEnd = offset + _BINARY_RECORD_HEADER_SIZE;
+		offset += (_BINARY_ALIGNMENT - headerEnd % _BINARY_ALIGNMENT) % _BINARY_ALIGNMENT;
+		const unsigned long long count = ReadInteger(8);
+		const unsigned int storedElementSize = (unsigned int)ReadInteger(4);
+		const binary_record storedType = (binary_record)ReadInteger(4);
+		if (storedType != type) {
+			throw std::runtime_error("Binary reader record is not the requested type!");
+		}
+		if (storedElementSize != elementSize) {
+			throw std::runtime_error("Binary reader record element size does not match the requested type!");
+		}
+		return count;
+	}
+
+	/* Reads a single trivially copyable element from its raw bytes. */
+	template<typename T>
+	constexpr T ReadElement() {
+		Require(sizeof(T));
+		if (std::is_constant_evaluated()) {
+			std::array<unsigned char, sizeof(T)> elementBytes{};
+			std::copy(bytes + offset, bytes + offset + sizeof(T), elementBytes.begin());
+			offset += sizeof(T);
+			return std::bit_cast<T>(elementBytes);
+		}
+		T element;
+		std::memcpy(&element, bytes + offset, sizeof(T));
+		offset += sizeof(T);
+		return element;
+	}
+
+	/* Adds count elements to the end of an array. At runtime they are copied straight from the buffer into the array's storage with a single memcpy. */
+	template<typename T>
+	constexpr void ReadElements(darray<T>& arr, unsigned long long count) {
+		Require(count, sizeof(T));
+		if (std::is_constant_evaluated()) {
+			arr.Reserve(arrint(count));
+			for (unsigned long long i = 0; i < count; i++) {
+				arr.Add(ReadElement<T>());
+			}
+			return;
+		}
+		if (count == 0) return;
+		T* out = arr.AddUninitialized(arrint(count));
+		std::memcpy(out, bytes + offset, size_t(count) * sizeof(T));
+		offset += size_t(count) * sizeof(T);
+	}
+
+public:
+
+	/* Validates the file header. */
+	constexpr binary_reader(const unsigned char* inBytes, size_t inSize)
+		: bytes(inBytes), size(inSize), offset(0)
+	{
+		Require(_BINARY_FILE_HEADER_SIZE);
+		if (bytes[0] != 'C' || bytes[1] != 'T' || bytes[2] != 'L' || bytes[3] != 'B') {
+			throw std::runtime_error("Binary reader buffer is not in the binary format!");
+		}
+		offset = 4;
+		if (ReadInteger(4) > _BINARY_FORMAT_VERSION) {
+			throw std::runtime_error("Binary reader buffer was written by a newer format version!");
+		}
+		if (ReadInteger(1) != (std::endian::native == std::endian::little ? 0 : 1)) {
+			throw std::runtime_error("Binary reader buffer was written with a different byte order!");
+		}
+		offset = _BINARY_FILE_HEADER_SIZE;
+	}
+
+	/* @return If every byte of the buffer has been read. */
+	[[nodiscard]] constexpr bool IsAtEnd() const { return offset >= size; }
+
+	/* Reads an array of trivially copyable elements into a new darray. */
+	template<typename T>
+	[[nodiscard]] constexpr darray<T> ReadArray() {
+		static_assert(std::is_trivially_copyable_v<T>, "Only arrays of trivially copyable elements can be deserialized");
+		const unsigned long long count = ReadRecordHeader(binary_record::Array, sizeof(T));
+		Require(count, sizeof(T));
+		darray<T> arr;
+		ReadElements(arr, count);
+		return arr;
+	}
+
+	/* Reads the characters of a string into a new string. */
+	template<size_t BUFFER_SIZE = 32>
+	[[nodiscard]] constexpr buffer_string<BUFFER_SIZE> ReadString() {
+		const unsigned long long len = ReadRecordHeader(binary_record::String, 1);
+		Require(len);
+		Require(len + 1);
+		if (bytes[offset + len] != '\0') {
+			throw std::runtime_error("Binary reader string is not null terminated!");
+		}
+		// Built from the stored length rather than measured, so characters after an embedded null are kept.
+		buffer_string<BUFFER_SIZE> str;
+		char* out = str.ConstructForWrite(size_t(len));
+		if (std::is_constant_evaluated()) {
+			for (unsigned long long i = 0; i < len; i++) {
+				out[i] = (char)bytes[offset + i];
+			}
+		}
+		else if (len > 0) {
+			std::memcpy(out, bytes + offset, size_t(len));
+		}
+		offset += len + 1;
+		return str;
+	}
+
+	/* Reads the bits of a bitset. */
+	template<size_t bitCount>
+	[[nodiscard]] constexpr bitset<bitCount> ReadBitset() {
+		using Bittype = typename bitset<bitCount>::Bittype;
+		const unsigned long long count = ReadRecordHeader(binary_record::Bitset, sizeof(Bittype));
+		if (count != bitCount) {
+			throw std::runtime_error("Binary reader bitset has a different bit count!");
+		}
+		return bitset<bitCount>((Bittype)ReadInteger(8));
+	}
+
+	/* Reads the blocks of a bloom filter into a new filter. */
+	[[nodiscard]] constexpr blocked_bloom_filter ReadBloomFilter() {
+		const unsigned long long count = ReadRecordHeader(binary_record::BloomFilter, sizeof(bloom_block));
+		Require(count, sizeof(bloom_block));
+		darray<bloom_block> blocks;
+		ReadElements(blocks, count);
+		return blocked_bloom_filter(std::move(blocks));
+	}
+
+	/* Views an array of trivially copyable elements directly within the buffer, without copying. Not constexpr valid. */
+	template<typename T>
+	[[nodiscard]] std::span<const T> ViewArray() {
+		static_assert(std::is_trivially_copyable_v<T>, "Only arrays of trivially copyable elements can be viewed");
+		const unsigned long long count = ReadRecordHeader(binary_record::Array, sizeof(T));
+		Require(count, sizeof(T));
+		const unsigned char* elements = bytes + offset;
+		if (uintptr_t(elements) % alignof(T) != 0) {
+			throw std::runtime_error("Binary reader buffer is not aligned enough to view the array!");
+		}
+		offset += count * sizeof(T);
+		return std::span<const T>((const T*)elements, size_t(count));
+	}
+
+	/* Views the characters of a string directly within the buffer, without copying. The view is null terminated. Not constexpr valid. */
+	[[nodiscard]] std::string_view ViewString() {
+		const unsigned long long len = ReadRecordHeader(binary_record::String, 1);
+		Require(len);
+		Require(len + 1);
+		if (bytes[offset + len] != '\0') {
+			throw std::runtime_error("Binary reader string is not null terminated!");
+		}
+		const char* chars = (const char*)(bytes + offset);
+		offset += len + 1;
+		return std::string_view(chars, size_t(len));
+	}
+
+};
@@ -0,0 +1,130 @@
+#include "binary_serialization.h"
+#include "../types/string/string_builder.h"
+
+#define TEST_TYPES "Binary Serialization"
+#include <testframework/unit_test_compile_time.h>
+
+namespace BinarySerializationUnitTests
+{
+
+#pragma region Header
+
+	constexpr bool HeaderSize() {
+		binary_writer writer;
+		return writer.Size() == _BINARY_FILE_HEADER_SIZE;
+	}
+	TEST_ASSERT(HeaderSize(), "Binary writer does not write only the file header when empty");
+
+	constexpr bool HeaderRoundTrip() {
+		binary_writer writer;
+		binary_reader reader(writer.Data(), writer.Size());
+		return reader.IsAtEnd();
+	}
+	TEST_ASSERT(HeaderRoundTrip(), "Binary reader does not accept an empty buffer written by binary writer");
+
+#pragma endregion
+
+#pragma region Alignment
+
+	constexpr bool PayloadAligned() {
+		binary_writer writer;
+		writer.Write(string("a"));
+		darray<int> arr;
+		arr.Add(1);
+		writer.Write(arr);
+		// header to 32, padding to 48, record header to 64, "a\0" to 66, padding to 80, record header to 96, then 1 int.
+		return writer.Size() == 96 + sizeof(int);
+	}
+	TEST_ASSERT(PayloadAligned(), "Binary writer does not align record payloads to 32 bytes");
+
+#pragma endregion
+
+#pragma region Round_Trip
+
+	constexpr bool ArrayRoundTrip() {
+		darray<int> arr;
+		for (int i = 0; i < 100; i++) {
+			arr.Add(i * 3 - 50);
+		}
+		binary_writer writer;
+		writer.Write(arr);
+
+		binary_reader reader(writer.Data(), writer.Size());
+		darray<int> out = reader.ReadArray<int>();
+		if (out.Size() != arr.Size()) return false;
+		for (int i = 0; i < 100; i++) {
+			if (out[i] != arr[i]) return false;
+		}
+		return reader.IsAtEnd();
+	}
+	TEST_ASSERT(ArrayRoundTrip(), "Array does not round trip through binary serialization");
+
+	constexpr bool StringRoundTrip() {
+		binary_writer writer;
+		writer.Write(string("small"));
+		writer.Write(string("a long string that does not fit in the sso buffer"));
+
+		binary_reader reader(writer.Data(), writer.Size());
+		string small = reader.ReadString();
+		string large = reader.ReadString();
+		return small == "small" && large == "a long string that does not fit in the sso buffer" && reader.IsAtEnd();
+	}
+	TEST_ASSERT(StringRoundTrip(), "Strings do not round trip through binary serialization");
+
+	constexpr bool StringEmbeddedNullRoundTrip() {
+		string_builder builder;
+		builder.Append("ab");
+		builder.Append('\0');
+		builder.Append("cd");
+		const string str = builder.Finish();
+		binary_writer writer;
+		writer.Write(str);
+
+		binary_reader reader(writer.Data(), writer.Size());
+		const string out = reader.ReadString();
+		return out.Len() == 5 && out.CStr()[2] == '\0' && out.CStr()[3] == 'c' && out.CStr()[4] == 'd';
+	}
+	TEST_ASSERT(StringEmbeddedNullRoundTrip(), "String with an embedded null does not keep its stored length through binary serialization");
+
+	constexpr bool BitsetRoundTrip() {
+		binary_writer writer;
+		writer.Write(bitset<12>(0xABC));
+		writer.Write(bitset<64>(0x8000000000000001ULL));
+
+		binary_reader reader(writer.Data(), writer.Size());
+		return reader.ReadBitset<12>() == 0xABC && reader.ReadBitset<64>() == 0x8000000000000001ULL;
+	}
+	TEST_ASSERT(BitsetRoundTrip(), "Bitsets do not round trip through binary serialization");
+
+	constexpr bool MixedRoundTrip() {
+		darray<double> arr;
+		arr.Add(1.5);
+		arr.Add(-2.25);
+		binary_writer writer;
+		writer.Write(string("name"));
+		writer.Write(arr);
+		writer.Write(bitset<8>(5));
+
+		binary_reader reader(writer.Data(), writer.Size());
+		const bool name = reader.ReadString() == "name";
+		darray<double> out = reader.ReadArray<double>();
+		const bool bits = reader.ReadBitset<8>() == 5;
+		return name && out.Size() == 2 && out[0] == 1.5 && out[1] == -2.25 && bits && reader.IsAtEnd();
+	}
+	TEST_ASSERT(MixedRoundTrip(), "Mixed records do not round trip through binary serialization");
+
+	constexpr bool BloomFilterRoundTrip() {
+		blocked_bloom_filter filter(100);
+		filter.Add(string("present"));
+		binary_writer writer;
+		writer.Write(filter);
+
+		binary_reader reader(writer.Data(), writer.Size());
+		blocked_bloom_filter out = reader.ReadBloomFilter();
+		return out.BlockCount() == filter.BlockCount() && out.MayContain(string("present")) && reader.IsAtEnd();
+	}
+	TEST_ASSERT(BloomFilterRoundTrip(), "Bloom filter does not round trip through binary serialization");
+
+#pragma endregion
+
+}
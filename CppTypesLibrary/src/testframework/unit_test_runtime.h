@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdio>
+
+#ifndef RUN_UNIT_TESTS_AT_RUNTIME
+#define RUN_UNIT_TESTS_AT_RUNTIME true
+#endif
+
+/* A single runtime unit test. Registered by RUNTIME_TEST_ASSERT into a list built during static initialization, without allocating. */
+struct runtime_unit_test
+{
+	const char* types;
+	const char* name;
+	const char* message;
+	bool (*test)();
+	runtime_unit_test* next;
+};
+
+/* Runtime unit tests, for behaviour that can't be checked at compile time, such as threads, thread local state and the heap. */
+struct runtime_unit_tests
+{
+	static runtime_unit_test*& Head() {
+		static runtime_unit_test* head = nullptr;
+		return head;
+	}
+
+	static bool Register(runtime_unit_test& unitTest) {
+		unitTest.next = Head();
+		Head() = &unitTest;
+		return true;
+	}
+
+	/* Runs every registered test, printing the ones that fail.
+	@return The number of failed tests. */
+	static int RunAll() {
+		int failed = 0;
+		for (runtime_unit_test* unitTest = Head(); unitTest != nullptr; unitTest = unitTest->next) {
+			if (!unitTest->test()) {
+				std::printf("[%s Unit Test]: %s... %s\n", unitTest->types, unitTest->name, unitTest->message);
+				failed++;
+			}
+		}
+		return failed;
+	}
+};
+
+#define _RUNTIME_TEST_CONCAT_IMPL(a, b) a##b
+#define _RUNTIME_TEST_CONCAT(a, b) _RUNTIME_TEST_CONCAT_IMPL(a, b)
+
+#if RUN_UNIT_TESTS_AT_RUNTIME == true
+
+/* Runtime test assertion. Registers a test that runtime_unit_tests::RunAll() calls from main(). Requires TEST_TYPES to be defined.
+By setting RUN_UNIT_TESTS_AT_RUNTIME to false, tests are not registered.
+@param test: Function returning bool to check.
+@param message: Message to display upon test failing. */
+#define RUNTIME_TEST_ASSERT(test, message) \
+static runtime_unit_test _RUNTIME_TEST_CONCAT(_runtimeUnitTest, __LINE__){ TEST_TYPES, #test, message, []() { return (bool)(test); }, nullptr }; \
+static const bool _RUNTIME_TEST_CONCAT(_runtimeUnitTestRegistered, __LINE__) = runtime_unit_tests::Register(_RUNTIME_TEST_CONCAT(_runtimeUnitTest, __LINE__))
+
+#else
+
+/* Will not execute. Define RUN_UNIT_TESTS_AT_RUNTIME to true to make tests run. */
+#define RUNTIME_TEST_ASSERT(test, message)
+
+#endif
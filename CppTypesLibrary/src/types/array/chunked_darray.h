@@ -0,0 +1,299 @@
+#pragma once
+
+#include "dynamic_array.h"
+#include <bit>
+#include <iterator>
+
+/* Per-thread free list of element chunks for chunked_darray, so that arrays created and destroyed repeatedly don't go back to the heap for every chunk. Not constexpr valid. */
+template<typename T, arrint CHUNK_SIZE>
+struct darray_chunk_pool
+{
+	/* Maximum number of free chunks kept per thread. Anything past this is deleted. */
+	static constexpr arrint MAX_FREE_CHUNKS = 64;
+
+	/* @return A chunk from the calling thread's pool, or a newly allocated chunk if the pool is empty. */
+	[[nodiscard]] static T* Acquire() {
+		darray_chunk_pool& pool = Get();
+		if (pool.freeCount == 0) {
+			alloc_tracker<darray_chunk_pool>::RecordAllocation(sizeof(T) * CHUNK_SIZE);
+			return new T[CHUNK_SIZE];
+		}
+		pool.freeCount--;
+		return pool.freeChunks[pool.freeCount];
+	}
+
+	/* Returns a chunk to the calling thread's pool. Its elements must already be reset. */
+	static void Release(T* chunk) {
+		darray_chunk_pool& pool = Get();
+		if (pool.freeCount == MAX_FREE_CHUNKS) {
+			delete[] chunk;
+			return;
+		}
+		pool.freeChunks[pool.freeCount] = chunk;
+		pool.freeCount++;
+	}
+
+	~darray_chunk_pool() {
+		for (arrint i = 0; i < freeCount; i++) {
+			delete[] freeChunks[i];
+		}
+	}
+
+private:
+
+	T* freeChunks[MAX_FREE_CHUNKS];
+
+	arrint freeCount = 0;
+
+	static darray_chunk_pool& Get() {
+		thread_local darray_chunk_pool pool;
+		return pool;
+	}
+
+};
+
+/* A dynamic array that stores its elements in fixed size chunks, and never moves an element once added. Pointers and references to elements stay valid
+until the array is cleared or destroyed. Growing allocates one new chunk instead of copying every element, so Add() has no latency spikes.
+Chunks come from a per-thread pool at runtime. Index lookup is a shift and a mask, and each chunk is contiguous for fast iteration.
+@param T: Element type. Must be default constructible.
+@param CHUNK_SIZE: Number of elements per chunk. Must be a power of two. */
+template<typename T, arrint CHUNK_SIZE = 256>
+struct chunked_darray
+{
+	static_assert(std::has_single_bit(CHUNK_SIZE), "chunked_darray chunk size must be a power of two");
+
+private:
+
+	static constexpr arrint CHUNK_SHIFT = arrint(std::countr_zero(CHUNK_SIZE));
+	static constexpr arrint CHUNK_MASK = CHUNK_SIZE - 1;
+
+	/* Pointers to each chunk. Only these pointers are moved when the table grows. */
+	darray<T*> chunks;
+	arrint size;
+
+	[[nodiscard]] constexpr static T* AcquireChunk() {
+		if (std::is_constant_evaluated()) {
+			return new T[CHUNK_SIZE];
+		}
+		return darray_chunk_pool<T, CHUNK_SIZE>::Acquire();
+	}
+
+	constexpr static void ReleaseChunk(T* chunk, arrint used) {
+		if (std::is_constant_evaluated()) {
+			delete[] chunk;
+			return;
+		}
+		// Reset the elements so the pooled chunk doesn't keep their resources alive.
+		for (arrint i = 0; i < used; i++) {
+			chunk[i] = T();
+		}
+		darray_chunk_pool<T, CHUNK_SIZE>::Release(chunk);
+	}
+
+	/* Returns every chunk to the pool. Leaves the chunk list and size as they are, so the destructor never touches the heap. */
+	constexpr void ReleaseAllChunks() {
+		for (arrint i = 0; i < chunks.Size(); i++) {
+			const arrint chunkStart = i << CHUNK_SHIFT;
+			const arrint used = size > chunkStart ? (size - chunkStart < CHUNK_SIZE ? size - chunkStart : CHUNK_SIZE) : 0;
+			ReleaseChunk(chunks.Data()[i], used);
+		}
+	}
+
+	/* @return The slot for the next element, acquiring a new chunk if every chunk is full. */
+	constexpr T& NextSlot() {
+		if (size == Capacity()) {
+			chunks.Add(AcquireChunk());
+		}
+		return chunks.Data()[size >> CHUNK_SHIFT][size & CHUNK_MASK];
+	}
+
+public:
+
+	/* Iterates the elements in order, moving to the next chunk only at the end of each contiguous chunk, and never past the last chunk holding elements. */
+	template<typename Element>
+	struct chunked_iterator
+	{
+		T* const* chunk;
+		T* const* lastChunk;
+		Element* current;
+		Element* chunkEnd;
+
+		[[nodiscard]] constexpr Element& operator * () const { return *current; }
+
+		[[nodiscard]] constexpr Element* operator -> () const { return current; }
+
+		constexpr chunked_iterator& operator ++ () {
+			current++;
+			if (current == chunkEnd && chunk != lastChunk) {
+				chunk++;
+				current = *chunk;
+				chunkEnd = current + CHUNK_SIZE;
+			}
+			return *this;
+		}
+
+		/* Compares the chunk first, as element pointers into different chunks can't be compared in constant evaluation. */
+		[[nodiscard]] constexpr bool operator == (const chunked_iterator& other) const {
+			return chunk == other.chunk && current == other.current;
+		}
+	};
+
+	using iterator = chunked_iterator<T>;
+	using const_iterator = chunked_iterator<const T>;
+
+	constexpr chunked_darray()
+		: chunks(), size(0)
+	{}
+
+	/* Copies every element into new chunks. */
+	constexpr chunked_darray(const chunked_darray& other)
+		: chunks(), size(0)
+	{
+		other.ForEachChunk([this](const T* elements, arrint count) {
+			for (arrint i = 0; i < count; i++) {
+				Add(elements[i]);
+			}
+		});
+	}
+
+	/* Takes the other array's chunks. The other array is left empty. No elements move, so pointers to them remain valid. */
+	constexpr chunked_darray(chunked_darray&& other) noexcept
+		: chunks(std::move(other.chunks)), size(other.size)
+	{
+		other.size = 0;
+	}
+
+	constexpr ~chunked_darray() {
+		ReleaseAllChunks();
+	}
+
+	constexpr chunked_darray& operator = (const chunked_darray& other) {
+		if (this == &other) return *this;
+		Clear();
+		other.ForEachChunk([this](const T* elements, arrint count) {
+			for (arrint i = 0; i < count; i++) {
+				Add(elements[i]);
+			}
+		});
+		return *this;
+	}
+
+	constexpr chunked_darray& operator = (chunked_darray&& other) noexcept {
+		if (this == &other) return *this;
+		ReleaseAllChunks();
+		chunks = std::move(other.chunks);
+		size = other.size;
+		other.size = 0;
+		return *this;
+	}
+
+	/* @return The number of elements currently held in the array. */
+	constexpr arrint Size() const {
+		return size;
+	}
+
+	/* @return The number of elements the acquired chunks can hold. */
+	constexpr arrint Capacity() const {
+		return chunks.Size() << CHUNK_SHIFT;
+	}
+
+	/* @return The number of acquired chunks. */
+	constexpr arrint ChunkCount() const {
+		return chunks.Size();
+	}
+
+	constexpr bool IsEmpty() const {
+		return size == 0;
+	}
+
+	/* Bounds checked according to CONTAINER_CHECK_POLICY. */
+	constexpr T& At(arrint index) {
+		bounds_check::Index(index, size, "Chunked array element At() index is out of bounds!");
+		return chunks.Data()[index >> CHUNK_SHIFT][index & CHUNK_MASK];
+	}
+
+	constexpr const T& At(arrint index) const {
+		bounds_check::Index(index, size, "Chunked array element At() index is out of bounds!");
+		return chunks.Data()[index >> CHUNK_SHIFT][index & CHUNK_MASK];
+	}
+
+	constexpr T& operator [] (arrint index) {
+		return At(index);
+	}
+
+	constexpr const T& operator [] (arrint index) const {
+		return At(index);
+	}
+
+	/* Adds an element. Never moves existing elements. @return Reference to the added element, which stays valid until the array is cleared or destroyed. */
+	constexpr T& Add(T&& element) {
+		T& slot = NextSlot();
+		slot = std::move(element);
+		size++;
+		return slot;
+	}
+
+	/* Adds an element. Never moves existing elements. @return Reference to the added element, which stays valid until the array is cleared or destroyed. */
+	constexpr T& Add(const T& element) {
+		T& slot = NextSlot();
+		slot = element;
+		size++;
+		return slot;
+	}
+
+	/* Acquires chunks until at least newCapacity elements can be held. */
+	constexpr void Reserve(arrint newCapacity) {
+		while (Capacity() < newCapacity) {
+			chunks.Add(AcquireChunk());
+		}
+	}
+
+	/* Removes every element and returns the chunks to the pool. */
+	constexpr void Clear() {
+		ReleaseAllChunks();
+		chunks.Clear();
+		size = 0;
+	}
+
+	/* Calls func(T* elements, arrint count) once for each contiguous chunk of elements, in order. */
+	template<typename Func>
+	constexpr void ForEachChunk(Func&& func) {
+		for (arrint chunkStart = 0; chunkStart < size; chunkStart += CHUNK_SIZE) {
+			const arrint count = size - chunkStart < CHUNK_SIZE ? size - chunkStart : CHUNK_SIZE;
+			func(chunks[chunkStart >> CHUNK_SHIFT], count);
+		}
+	}
+
+	/* Calls func(const T* elements, arrint count) once for each contiguous chunk of elements, in order. */
+	template<typename Func>
+	constexpr void ForEachChunk(Func&& func) const {
+		for (arrint chunkStart = 0; chunkStart < size; chunkStart += CHUNK_SIZE) {
+			const arrint count = size - chunkStart < CHUNK_SIZE ? size - chunkStart : CHUNK_SIZE;
+			func((const T*)chunks.Data()[chunkStart >> CHUNK_SHIFT], count);
+		}
+	}
+
+	[[nodiscard]] constexpr iterator begin() { return MakeIterator<T>(0); }
+
+	[[nodiscard]] constexpr iterator end() { return MakeIterator<T>(size); }
+
+	[[nodiscard]] constexpr const_iterator begin() const { return MakeIterator<const T>(0); }
+
+	[[nodiscard]] constexpr const_iterator end() const { return MakeIterator<const T>(size); }
+
+private:
+
+	template<typename Element>
+	[[nodiscard]] constexpr chunked_iterator<Element> MakeIterator(arrint index) const {
+		if (size == 0) {
+			return chunked_iterator<Element>{ nullptr, nullptr, nullptr, nullptr };
+		}
+		// The end of a full last chunk is one past its final element, within the last chunk rather than the start of the next.
+		const arrint chunkIndex = index == size ? (size - 1) >> CHUNK_SHIFT : index >> CHUNK_SHIFT;
+		T* const* chunk = chunks.Data() + chunkIndex;
+		T* const* lastChunk = chunks.Data() + ((size - 1) >> CHUNK_SHIFT);
+		Element* current = *chunk + (index - (chunkIndex << CHUNK_SHIFT));
+		return chunked_iterator<Element>{ chunk, lastChunk, current, *chunk + CHUNK_SIZE };
+	}
+
+};
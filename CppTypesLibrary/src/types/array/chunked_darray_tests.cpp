@@ -0,0 +1,140 @@
+#include "chunked_darray.h"
+
+#define TEST_TYPES "Chunked Dynamic Array"
+#include <testframework/unit_test_compile_time.h>
+
+#include "../string/string.h"
+
+namespace ChunkedDynamicArrayUnitTests
+{
+
+#pragma region Add
+
+	constexpr bool DefaultEmpty() {
+		chunked_darray<int> arr;
+		return arr.IsEmpty() && arr.Size() == 0 && arr.ChunkCount() == 0;
+	}
+	TEST_ASSERT(DefaultEmpty(), "Default chunked array is not empty");
+
+	constexpr bool AddAcrossChunks() {
+		chunked_darray<int, 4> arr;
+		for (int i = 0; i < 10; i++) {
+			arr.Add(i);
+		}
+		if (arr.Size() != 10 || arr.ChunkCount() != 3 || arr.Capacity() != 12) return false;
+		for (arrint i = 0; i < 10; i++) {
+			if (arr[i] != int(i)) return false;
+		}
+		return true;
+	}
+	TEST_ASSERT(AddAcrossChunks(), "Chunked array elements across chunks are incorrect");
+
+	constexpr bool AddressesStable() {
+		chunked_darray<int, 4> arr;
+		int* first = &arr.Add(1);
+		int* fifth = nullptr;
+		for (int i = 0; i < 100; i++) {
+			int& added = arr.Add(i);
+			if (i == 3) fifth = &added;
+		}
+		return first == &arr[0] && fifth == &arr[4] && *first == 1 && *fifth == 3;
+	}
+	TEST_ASSERT(AddressesStable(), "Chunked array elements move when adding");
+
+	constexpr bool StringElements() {
+		chunked_darray<string, 2> arr;
+		for (int i = 0; i < 5; i++) {
+			arr.Add(string("a string long enough to need a heap allocation"));
+		}
+		arr.Add(string("short"));
+		return arr.Size() == 6 && arr[4] == "a string long enough to need a heap allocation" && arr[5] == "short";
+	}
+	TEST_ASSERT(StringElements(), "Chunked array of strings is incorrect");
+
+	constexpr bool ReserveAndClear() {
+		chunked_darray<int, 8> arr;
+		arr.Reserve(20);
+		if (arr.Capacity() != 24 || arr.Size() != 0) return false;
+		arr.Add(5);
+		arr.Clear();
+		return arr.IsEmpty() && arr.ChunkCount() == 0;
+	}
+	TEST_ASSERT(ReserveAndClear(), "Chunked array Reserve() or Clear() is incorrect");
+
+#pragma endregion
+
+#pragma region Iterate
+
+	constexpr bool IterateInOrder() {
+		chunked_darray<int, 4> arr;
+		for (int i = 0; i < 8; i++) {
+			arr.Add(i);
+		}
+		int expected = 0;
+		for (int element : arr) {
+			if (element != expected) return false;
+			expected++;
+		}
+		return expected == 8;
+	}
+	TEST_ASSERT(IterateInOrder(), "Chunked array iteration with a full last chunk is incorrect");
+
+	constexpr bool IteratePartialChunk() {
+		chunked_darray<int, 4> arr;
+		for (int i = 0; i < 6; i++) {
+			arr.Add(i);
+		}
+		int sum = 0;
+		for (int& element : arr) {
+			sum += element;
+		}
+		chunked_darray<int, 4> empty;
+		for (int element : empty) {
+			sum += element + 100;
+		}
+		return sum == 15;
+	}
+	TEST_ASSERT(IteratePartialChunk(), "Chunked array iteration with a partial last chunk is incorrect");
+
+	constexpr bool ForEachChunkCounts() {
+		chunked_darray<int, 4> arr;
+		for (int i = 0; i < 9; i++) {
+			arr.Add(i);
+		}
+		arrint calls = 0;
+		arrint total = 0;
+		arr.ForEachChunk([&](int* elements, arrint count) {
+			calls++;
+			total += count;
+			if (elements[0] != int(calls - 1) * 4) total += 100;
+		});
+		return calls == 3 && total == 9;
+	}
+	TEST_ASSERT(ForEachChunkCounts(), "Chunked array ForEachChunk() does not visit each chunk once");
+
+#pragma endregion
+
+#pragma region Copy_Move
+
+	constexpr bool CopyThenModify() {
+		chunked_darray<int, 4> arr;
+		for (int i = 0; i < 6; i++) {
+			arr.Add(i);
+		}
+		chunked_darray<int, 4> copy = arr;
+		copy[0] = 100;
+		return copy.Size() == 6 && copy[5] == 5 && arr[0] == 0;
+	}
+	TEST_ASSERT(CopyThenModify(), "Chunked array copy shares elements with the original");
+
+	constexpr bool MoveKeepsAddresses() {
+		chunked_darray<int, 4> arr;
+		int* first = &arr.Add(7);
+		chunked_darray<int, 4> moved = std::move(arr);
+		return &moved[0] == first && arr.Size() == 0 && moved.Size() == 1;
+	}
+	TEST_ASSERT(MoveKeepsAddresses(), "Chunked array move relocates elements");
+
+#pragma endregion
+
+}
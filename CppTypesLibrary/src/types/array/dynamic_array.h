@@ -2,6 +2,11 @@
 
 #include <utility>
 #include <stdexcept>
+#include <type_traits>
+#include <cstring>
+#include <span>
+#include "../../diagnostics/alloc_tracking.h"
+#include "../../diagnostics/bounds_checking.h"
 
 /* Array integer type */
 typedef unsigned int arrint;
@@ -34,15 +39,34 @@ public:
 		return data;
 	}
 
-private:
+	/* @return Raw array data pointer. */
+	constexpr const T* Data() const {
+		return data;
+	}
 
-	constexpr void Reallocate() {
-		const arrint newCapacity = capacity * 2;
+private:
 
-		T* newData = new T[newCapacity];
+	/* Moves every element into a new allocation. Trivially copyable elements are copied with a single memcpy at runtime. */
+	constexpr void MoveElementsTo(T* newData) {
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			if (!std::is_constant_evaluated()) {
+				if (size > 0) {
+					std::memcpy(newData, data, sizeof(T) * size);
+				}
+				return;
+			}
+		}
 		for (arrint i = 0; i < Size(); i++) {
 			newData[i] = std::move(data[i]);
 		}
+	}
+
+	constexpr void Reallocate() {
+		const arrint newCapacity = capacity == 0 ? DEFAULT_CAPACITY : capacity * 2;
+
+		T* newData = new T[newCapacity];
+		alloc_tracker<darray<T>>::RecordReallocation(sizeof(T) * newCapacity);
+		MoveElementsTo(newData);
 		delete[] data;
 		data = newData;
 		capacity = newCapacity;
@@ -52,42 +76,136 @@ public:
 
 	constexpr darray() {
 		data = new T[DEFAULT_CAPACITY];
+		alloc_tracker<darray<T>>::RecordAllocation(sizeof(T) * DEFAULT_CAPACITY);
 		size = 0;
 		capacity = DEFAULT_CAPACITY;
 	}
 
+	/* Copies every element into a new allocation of the same capacity. */
+	constexpr darray(const darray<T>& other) {
+		data = new T[other.capacity];
+		alloc_tracker<darray<T>>::RecordAllocation(sizeof(T) * other.capacity);
+		size = other.size;
+		capacity = other.capacity;
+		for (arrint i = 0; i < size; i++) {
+			data[i] = other.data[i];
+		}
+	}
+
+	/* Takes the other array's data. The other array is left empty with no allocation. */
+	constexpr darray(darray<T>&& other) noexcept {
+		data = other.data;
+		size = other.size;
+		capacity = other.capacity;
+		other.data = nullptr;
+		other.size = 0;
+		other.capacity = 0;
+	}
+
 	constexpr ~darray() {
 		if (data != nullptr)
 			delete[] data;
 	}
 
+	constexpr darray<T>& operator = (const darray<T>& other) {
+		if (this == &other) return *this;
+
+		T* newData = new T[other.capacity];
+		alloc_tracker<darray<T>>::RecordAllocation(sizeof(T) * other.capacity);
+		for (arrint i = 0; i < other.size; i++) {
+			newData[i] = other.data[i];
+		}
+		if (data != nullptr)
+			delete[] data;
+		data = newData;
+		size = other.size;
+		capacity = other.capacity;
+		return *this;
+	}
+
+	constexpr darray<T>& operator = (darray<T>&& other) noexcept {
+		if (this == &other) return *this;
+
+		if (data != nullptr)
+			delete[] data;
+		data = other.data;
+		size = other.size;
+		capacity = other.capacity;
+		other.data = nullptr;
+		other.size = 0;
+		other.capacity = 0;
+		return *this;
+	}
+
 	/* If the new capacity is less than the array's current capacity, this function does nothing. */
 	constexpr void Reserve(arrint newCapacity) {
 		if (newCapacity < capacity) return;
 
 		T* newData = new T[newCapacity];
-		for (arrint i = 0; i < Size(); i++) {
-			newData[i] = std::move(data[i]);
-		}
+		alloc_tracker<darray<T>>::RecordReallocation(sizeof(T) * newCapacity);
+		MoveElementsTo(newData);
 		delete[] data;
 		data = newData;
 		capacity = newCapacity;
 	}
 
+	/* Bounds checked according to CONTAINER_CHECK_POLICY. Unchecked in release builds by default, so loops over the array can be vectorized. */
 	constexpr T& At(arrint index) {
-		if (index >= Size()) {
-			//if (std::is_constant_evaluated()) {
-			//}
-			throw std::out_of_range("Array element At() index is out of bounds!");
+		bounds_check::Index(index, size, "Array element At() index is out of bounds!");
+		return data[index];
+	}
+
+	/* Bounds checked according to CONTAINER_CHECK_POLICY. Unchecked in release builds by default, so loops over the array can be vectorized. */
+	constexpr const T& At(arrint index) const {
+		bounds_check::Index(index, size, "Array element At() index is out of bounds!");
+		return data[index];
+	}
+
+	/* Always bounds checked, whatever the CONTAINER_CHECK_POLICY. Throws std::out_of_range. */
+	constexpr T& Checked(arrint index) {
+		if (index >= size) {
+			throw std::out_of_range("Array element Checked() index is out of bounds!");
 		}
+		return data[index];
+	}
 
+	/* Always bounds checked, whatever the CONTAINER_CHECK_POLICY. Throws std::out_of_range. */
+	constexpr const T& Checked(arrint index) const {
+		if (index >= size) {
+			throw std::out_of_range("Array element Checked() index is out of bounds!");
+		}
 		return data[index];
 	}
 
+	/* Same as At(). */
 	constexpr T& operator [] (arrint index) {
 		return At(index);
 	}
 
+	/* Same as At(). */
+	constexpr const T& operator [] (arrint index) const {
+		return At(index);
+	}
+
+	/* Contiguous iterators are plain pointers, so darray is a std::ranges::contiguous_range. */
+	[[nodiscard]] constexpr T* begin() { return data; }
+
+	[[nodiscard]] constexpr T* end() { return data + size; }
+
+	[[nodiscard]] constexpr const T* begin() const { return data; }
+
+	[[nodiscard]] constexpr const T* end() const { return data + size; }
+
+	/* @return A view of every element. Invalidated when the array reallocates. */
+	[[nodiscard]] constexpr std::span<T> Span() {
+		return std::span<T>(data, size);
+	}
+
+	/* @return A view of every element. Invalidated when the array reallocates. */
+	[[nodiscard]] constexpr std::span<const T> Span() const {
+		return std::span<const T>(data, size);
+	}
+
 	constexpr void Add(T&& element) {
 		if (size == capacity) {
 			Reallocate();
@@ -106,7 +224,60 @@ public:
 		size++;
 	}
 
+	/* Grows the array by count elements without assigning them, so they can be written in bulk, such as with a single memcpy.
+	The new elements keep whatever their slots held before. Only for trivially copyable elements.
+	@return Pointer to the first new element. */
+	constexpr T* AddUninitialized(arrint count) {
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be added uninitialized");
+		if (size + count > capacity) {
+			Reserve(size + count);
+		}
+		T* first = data + size;
+		size += count;
+		return first;
+	}
+
+	/* Inserts an element before index, moving every element after it back by one. An index of Size() adds to the end. */
+	constexpr void Insert(arrint index, T&& element) {
+		if (index > size) {
+			throw std::out_of_range("Array Insert() index is out of bounds!");
+		}
+		if (size == capacity) {
+			Reallocate();
+		}
+
+		for (arrint i = size; i > index; i--) {
+			data[i] = std::move(data[i - 1]);
+		}
+		data[index] = std::move(element);
+		size++;
+	}
+
+	/* Inserts an element before index, moving every element after it back by one. An index of Size() adds to the end. */
+	constexpr void Insert(arrint index, const T& element) {
+		Insert(index, T(element));
+	}
 
+	/* Removes the element at index, moving every element after it forward by one. */
+	constexpr void RemoveAt(arrint index) {
+		if (index >= size) {
+			throw std::out_of_range("Array RemoveAt() index is out of bounds!");
+		}
 
+		for (arrint i = index; i + 1 < size; i++) {
+			data[i] = std::move(data[i + 1]);
+		}
+		// Reset the vacated slot so it doesn't keep the moved element's resources alive.
+		data[size - 1] = T();
+		size--;
+	}
+
+	/* Removes every element, keeping the allocation. */
+	constexpr void Clear() {
+		for (arrint i = 0; i < size; i++) {
+			data[i] = T();
+		}
+		size = 0;
+	}
 
 };
\ No newline at end of file
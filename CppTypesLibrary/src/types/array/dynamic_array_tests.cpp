@@ -4,6 +4,8 @@
 #include <testframework/unit_test_compile_time.h>
 
 #include "../string/string.h"
+#include <algorithm>
+#include <ranges>
 
 namespace DynamicArrayUnitTests 
 {
@@ -116,6 +118,48 @@ namespace DynamicArrayUnitTests
 
 #pragma endregion
 
+#pragma region Copy_Move
+
+	constexpr bool CopyConstruct() {
+		darray<string> arr;
+		arr.Add(string("hello"));
+		arr.Add(string("a string long enough to be on the heap"));
+		darray<string> copy = arr;
+		return copy.Size() == 2 && copy[0] == "hello" && copy[1] == "a string long enough to be on the heap" && arr[1] == copy[1];
+	}
+	TEST_ASSERT(CopyConstruct(), "Copy constructed array does not have the same elements");
+
+	constexpr bool MoveConstruct() {
+		darray<int> arr;
+		arr.Add(5);
+		darray<int> moved = std::move(arr);
+		return moved.Size() == 1 && moved[0] == 5 && arr.Size() == 0;
+	}
+	TEST_ASSERT(MoveConstruct(), "Move constructed array does not take the other array's elements");
+
+	constexpr bool MovedFromAdd() {
+		darray<int> arr;
+		arr.Add(5);
+		darray<int> moved = std::move(arr);
+		arr.Add(6);
+		arr.Add(7);
+		return arr.Size() == 2 && arr[0] == 6 && arr[1] == 7;
+	}
+	TEST_ASSERT(MovedFromAdd(), "Moved from array cannot have elements added to it");
+
+	constexpr bool CopyAssign() {
+		darray<int> a;
+		darray<int> b;
+		a.Add(1);
+		b.Add(2);
+		b.Add(3);
+		a = b;
+		return a.Size() == 2 && a[0] == 2 && a[1] == 3;
+	}
+	TEST_ASSERT(CopyAssign(), "Copy assigned array does not have the same elements");
+
+#pragma endregion
+
 #pragma region Index
 
 	constexpr bool GetIndexInRange() {
@@ -130,6 +174,125 @@ namespace DynamicArrayUnitTests
 	}
 	TEST_ASSERT(GetIndexInRange(), "Array indexing has incorrect elements");
 
+	constexpr bool GetIndexOutOfRange() {
+		darray<int> arr;
+		arr.Add(1);
+		return arr[1] == 0;
+	}
+
+	/* Out of bounds access must stay checked during constant evaluation whatever the CONTAINER_CHECK_POLICY, which makes the call non constant. */
+	template<bool (*FUNC)()>
+	constexpr bool IsConstant() {
+		return requires { typename std::bool_constant<FUNC()>; };
+	}
+	TEST_ASSERT(IsConstant<GetIndexInRange>() && !IsConstant<GetIndexOutOfRange>(), "Array indexing out of bounds is not checked during constant evaluation");
+
+#pragma endregion
+
+#pragma region Insert_Remove
+
+	constexpr bool InsertShifts() {
+		darray<int> arr;
+		arr.Add(1);
+		arr.Add(3);
+		arr.Insert(1, 2);
+		arr.Insert(0, 0);
+		arr.Insert(4, 4);
+		for (int i = 0; i < 5; i++) {
+			if (arr[i] != i) return false;
+		}
+		return arr.Size() == 5;
+	}
+	TEST_ASSERT(InsertShifts(), "Array Insert() does not place the element and shift the rest");
+
+	constexpr bool RemoveAtShifts() {
+		darray<string> arr;
+		arr.Add(string("zero"));
+		arr.Add(string("a string long enough to need a heap allocation"));
+		arr.Add(string("two"));
+		arr.RemoveAt(1);
+		arr.RemoveAt(1);
+		return arr.Size() == 1 && arr[0] == "zero";
+	}
+	TEST_ASSERT(RemoveAtShifts(), "Array RemoveAt() does not remove the element and shift the rest");
+
+	constexpr bool ClearEmpties() {
+		darray<int> arr;
+		for (int i = 0; i < 10; i++) {
+			arr.Add(i);
+		}
+		const arrint capacity = arr.Capacity();
+		arr.Clear();
+		return arr.Size() == 0 && arr.Capacity() == capacity;
+	}
+	TEST_ASSERT(ClearEmpties(), "Array Clear() does not empty the array while keeping its capacity");
+
+	constexpr bool AddUninitializedGrows() {
+		darray<int> arr;
+		arr.Add(1);
+		int* out = arr.AddUninitialized(20);
+		for (int i = 0; i < 20; i++) {
+			out[i] = i + 2;
+		}
+		return arr.Size() == 21 && arr.Capacity() >= 21 && arr[0] == 1 && arr[20] == 21;
+	}
+	TEST_ASSERT(AddUninitializedGrows(), "Array AddUninitialized() does not grow the array in place");
+
+#pragma endregion
+
+#pragma region Iterators
+
+	static_assert(std::ranges::contiguous_range<darray<int>>, "darray is not a contiguous range");
+	static_assert(std::ranges::contiguous_range<const darray<int>>, "const darray is not a contiguous range");
+
+	constexpr bool RangeForSum() {
+		darray<int> arr;
+		for (int i = 1; i <= 100; i++) {
+			arr.Add(i);
+		}
+		int sum = 0;
+		for (int value : arr) {
+			sum += value;
+		}
+		return sum == 5050 && arr.end() - arr.begin() == 100;
+	}
+	TEST_ASSERT(RangeForSum(), "Array range based for loop does not visit every element");
+
+	constexpr bool RangesAlgorithm() {
+		darray<int> arr;
+		for (int i = 0; i < 20; i++) {
+			arr.Add(19 - i);
+		}
+		std::ranges::sort(arr);
+		return std::ranges::is_sorted(arr) && arr[0] == 0 && arr[19] == 19 && std::ranges::find(arr, 7) == arr.begin() + 7;
+	}
+	TEST_ASSERT(RangesAlgorithm(), "Array is not usable with std::ranges algorithms");
+
+	constexpr bool SpanView() {
+		darray<string> arr;
+		arr.Add(string("a"));
+		arr.Add(string("b"));
+		std::span<string> view = arr.Span();
+		view[1] = "c";
+		const darray<string>& constArr = arr;
+		std::span<const string> constView = constArr.Span();
+		return view.size() == 2 && constView.data() == arr.Data() && constArr[1] == "c" && constArr.Checked(0) == "a";
+	}
+	TEST_ASSERT(SpanView(), "Array Span() does not view the elements");
+
+	constexpr bool ConstAccess() {
+		darray<int> arr;
+		arr.Add(4);
+		arr.Add(5);
+		const darray<int>& constArr = arr;
+		int sum = 0;
+		for (const int& value : constArr) {
+			sum += value;
+		}
+		return constArr.At(1) == 5 && constArr[0] == 4 && sum == 9;
+	}
+	TEST_ASSERT(ConstAccess(), "Const array access is incorrect");
+
 #pragma endregion
 
 
@@ -0,0 +1,310 @@
+#pragma once
+
+#include "dynamic_array.h"
+#include <type_traits>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* Access pattern hints for a mapped_darray, forwarded to the operating system's paging. */
+enum class mapped_access
+{
+	Normal,
+	Sequential,
+	Random,
+	WillNeed
+};
+
+/* A dynamic array whose elements live in a memory mapped file. Opening a file does no copying, elements are paged in by the os as they are accessed.
+Read only mappings can be shared between processes. Writable mappings grow the file as elements are added, and trim it to Size() when closed.
+Not constexpr valid. Throws std::runtime_error if the file cannot be opened, mapped, or grown.
+@param T: Element type. Must be trivially copyable, as elements are the raw bytes of the file. */
+template<typename T>
+struct mapped_darray
+{
+	static_assert(std::is_trivially_copyable_v<T>, "mapped_darray element type must be trivially copyable");
+
+private:
+
+	T* data;
+	arrint size;
+	arrint capacity;
+	bool writable;
+
+#ifdef _MSC_VER
+	HANDLE file;
+	HANDLE mapping;
+#else
+	int file;
+#endif
+
+	void Map(arrint newCapacity) {
+		const size_t bytes = size_t(newCapacity) * sizeof(T);
+		capacity = newCapacity;
+		if (bytes == 0) {
+			data = nullptr;
+			return;
+		}
+
+#ifdef _MSC_VER
+		const LARGE_INTEGER byteCount{ .QuadPart = (LONGLONG)bytes };
+		mapping = CreateFileMappingA(file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY, byteCount.HighPart, byteCount.LowPart, NULL);
+		if (mapping == NULL) {
+			throw std::runtime_error("mapped_darray failed to create file mapping!");
+		}
+		data = (T*)MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, bytes);
+		if (data == nullptr) {
+			CloseHandle(mapping);
+			mapping = NULL;
+			throw std::runtime_error("mapped_darray failed to map view of file!");
+		}
+#else
+		void* mapped = mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+		if (mapped == MAP_FAILED) {
+			data = nullptr;
+			throw std::runtime_error("mapped_darray failed to mmap file!");
+		}
+		data = (T*)mapped;
+#endif
+	}
+
+	void Unmap() {
+		if (data == nullptr) return;
+#ifdef _MSC_VER
+		UnmapViewOfFile(data);
+		CloseHandle(mapping);
+		mapping = NULL;
+#else
+		munmap(data, size_t(capacity) * sizeof(T));
+#endif
+		data = nullptr;
+	}
+
+	/* Sets the size of the underlying file in bytes. */
+	void ResizeFile(size_t bytes) {
+#ifdef _MSC_VER
+		const LARGE_INTEGER byteCount{ .QuadPart = (LONGLONG)bytes };
+		if (!SetFilePointerEx(file, byteCount, NULL, FILE_BEGIN) || !SetEndOfFile(file)) {
+			throw std::runtime_error("mapped_darray failed to resize file!");
+		}
+#else
+		if (ftruncate(file, off_t(bytes)) != 0) {
+			throw std::runtime_error("mapped_darray failed to resize file!");
+		}
+#endif
+	}
+
+	/* Grows the file and the mapping to a new element capacity. Uses mremap where available to avoid unmapping. */
+	void Remap(arrint newCapacity) {
+		const size_t bytes = size_t(newCapacity) * sizeof(T);
+#ifdef __linux__
+		ResizeFile(bytes);
+		if (data != nullptr) {
+			void* mapped = mremap(data, size_t(capacity) * sizeof(T), bytes, MREMAP_MAYMOVE);
+			if (mapped == MAP_FAILED) {
+				throw std::runtime_error("mapped_darray failed to mremap file!");
+			}
+			data = (T*)mapped;
+			capacity = newCapacity;
+			return;
+		}
+		Map(newCapacity);
+#else
+		Unmap();
+		ResizeFile(bytes);
+		Map(newCapacity);
+#endif
+	}
+
+	/* Unmaps and closes the file, trimming writable files to Size(). Never throws, as it runs in the destructor. */
+	void Close() {
+		Unmap();
+#ifdef _MSC_VER
+		if (file != INVALID_HANDLE_VALUE) {
+			if (writable) {
+				LARGE_INTEGER byteCount{ .QuadPart = LONGLONG(size_t(size) * sizeof(T)) };
+				SetFilePointerEx(file, byteCount, NULL, FILE_BEGIN);
+				SetEndOfFile(file);
+			}
+			CloseHandle(file);
+			file = INVALID_HANDLE_VALUE;
+		}
+#else
+		if (file != -1) {
+			if (writable) {
+				(void)ftruncate(file, off_t(size_t(size) * sizeof(T)));
+			}
+			close(file);
+			file = -1;
+		}
+#endif
+		size = 0;
+		capacity = 0;
+	}
+
+public:
+
+	/* Opens and maps a file. Read only files must already exist. Writable files are created if they don't exist.
+	@param path: Path to the file.
+	@param inWritable: Whether the file can be modified and grown through Add() and Reserve(). */
+	mapped_darray(const char* path, bool inWritable = false)
+		: data(nullptr), size(0), capacity(0), writable(inWritable)
+	{
+		size_t bytes;
+#ifdef _MSC_VER
+		mapping = NULL;
+		file = CreateFileA(path, writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, NULL,
+			writable ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE) {
+			throw std::runtime_error("mapped_darray failed to open file!");
+		}
+		LARGE_INTEGER fileSize;
+		GetFileSizeEx(file, &fileSize);
+		bytes = size_t(fileSize.QuadPart);
+#else
+		file = open(path, writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+		if (file == -1) {
+			throw std::runtime_error("mapped_darray failed to open file!");
+		}
+		struct stat fileStat;
+		fstat(file, &fileStat);
+		bytes = size_t(fileStat.st_size);
+#endif
+		size = arrint(bytes / sizeof(T));
+		try {
+			Map(size);
+		}
+		catch (...) {
+			writable = false;
+			Close();
+			throw;
+		}
+	}
+
+	mapped_darray(const mapped_darray&) = delete;
+
+	mapped_darray& operator = (const mapped_darray&) = delete;
+
+	mapped_darray(mapped_darray&& other) noexcept
+		: data(other.data), size(other.size), capacity(other.capacity), writable(other.writable), file(other.file)
+	{
+#ifdef _MSC_VER
+		mapping = other.mapping;
+		other.mapping = NULL;
+		other.file = INVALID_HANDLE_VALUE;
+#else
+		other.file = -1;
+#endif
+		other.data = nullptr;
+		other.size = 0;
+		other.capacity = 0;
+	}
+
+	~mapped_darray() {
+		Close();
+	}
+
+	/* @return The number of elements currently held in the array. */
+	arrint Size() const {
+		return size;
+	}
+
+	/* @return The number of elements the current mapping can hold before the file must grow. */
+	arrint Capacity() const {
+		return capacity;
+	}
+
+	/* @return If elements can be modified and added. */
+	bool IsWritable() const {
+		return writable;
+	}
+
+	/* DANGEROUS. @return Raw pointer to the mapped elements. Writing through this on a read only mapping will crash. */
+	T* Data() {
+		return data;
+	}
+
+	/* @return Raw pointer to the mapped elements. */
+	const T* Data() const {
+		return data;
+	}
+
+	/* Bounds checked according to CONTAINER_CHECK_POLICY. */
+	T& At(arrint index) {
+		bounds_check::Index(index, Size(), "Mapped array element At() index is out of bounds!");
+		return data[index];
+	}
+
+	const T& At(arrint index) const {
+		bounds_check::Index(index, Size(), "Mapped array element At() index is out of bounds!");
+		return data[index];
+	}
+
+	T& operator [] (arrint index) {
+		return At(index);
+	}
+
+	const T& operator [] (arrint index) const {
+		return At(index);
+	}
+
+	/* Grows the file so it can hold at least newCapacity elements. If the new capacity is less than the current capacity, this function does nothing. */
+	void Reserve(arrint newCapacity) {
+		if (!writable) {
+			throw std::runtime_error("mapped_darray cannot Reserve() on a read only mapping!");
+		}
+		if (newCapacity <= capacity) return;
+		Remap(newCapacity);
+	}
+
+	void Add(const T& element) {
+		if (!writable) {
+			throw std::runtime_error("mapped_darray cannot Add() to a read only mapping!");
+		}
+		if (size == capacity) {
+			Remap(capacity == 0 ? arrint(4096 / sizeof(T) + 1) : capacity * 2);
+		}
+		data[size] = element;
+		size++;
+	}
+
+	/* Hints to the os how the elements will be accessed, so it can read ahead or avoid it. */
+	void Advise(mapped_access access) {
+		if (data == nullptr) return;
+		const size_t bytes = size_t(capacity) * sizeof(T);
+#ifdef _MSC_VER
+		if (access == mapped_access::WillNeed) {
+			WIN32_MEMORY_RANGE_ENTRY range{ data, bytes };
+			PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+		}
+#else
+		int advice = MADV_NORMAL;
+		switch (access) {
+		case mapped_access::Normal: advice = MADV_NORMAL; break;
+		case mapped_access::Sequential: advice = MADV_SEQUENTIAL; break;
+		case mapped_access::Random: advice = MADV_RANDOM; break;
+		case mapped_access::WillNeed: advice = MADV_WILLNEED; break;
+		}
+		madvise(data, bytes, advice);
+#endif
+	}
+
+	/* Writes any modified elements back to the file. Does nothing for read only mappings. */
+	void Flush() {
+		if (!writable || data == nullptr) return;
+#ifdef _MSC_VER
+		FlushViewOfFile(data, size_t(size) * sizeof(T));
+		FlushFileBuffers(file);
+#else
+		msync(data, size_t(capacity) * sizeof(T), MS_SYNC);
+#endif
+	}
+
+};
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "dynamic_array.h"
+#include "../bitset/bitset.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* A dynamic array of unsigned integers that are each BITS wide, stored back to back in 64 bit words. A value may span two words.
+Values are read and written as the smallest unsigned type that holds BITS bits, the same Bittype bitset<BITS> uses, and values wider than BITS are truncated.
+An extra zeroed word is always kept past the last value, so bulk decoding can load whole words without bounds checks.
+Unpack() and ForEach() decode 8 values per AVX2 step at runtime when BITS is at most 25. Get() and Set() are bounds checked according to CONTAINER_CHECK_POLICY,
+and Unpack() throws std::out_of_range on out of bounds ranges.
+@param BITS: Bits per value, from 1 to 64. */
+template<size_t BITS>
+struct packed_darray
+{
+	static_assert(BITS > 0, "packed_darray bits per value must be greater than 0");
+	static_assert(BITS < 65, "packed_darray bits per value must be less than 65");
+
+	typedef typename bitset<BITS>::Bittype Bittype;
+
+	/* Number of values ForEach() decodes per step. */
+	static constexpr arrint DECODE_BLOCK = 16;
+
+private:
+
+	static constexpr unsigned long long VALUE_MASK = BITS == 64 ? ~0ULL : (1ULL << BITS) - 1;
+
+	darray<unsigned long long> words;
+	arrint size;
+
+	/* @return The words needed for count values, including the trailing padding word. */
+	[[nodiscard]] constexpr static arrint WordsFor(arrint count) {
+		return arrint(((unsigned long long)count * BITS + 63) / 64) + 1;
+	}
+
+	constexpr void EnsureWords(arrint count) {
+		const arrint required = WordsFor(count);
+		if (words.Capacity() < required) {
+			words.Reserve(required);
+		}
+		while (words.Size() < required) {
+			words.Add(0);
+		}
+	}
+
+	[[nodiscard]] constexpr Bittype Read(arrint index) const {
+		const unsigned long long bit = (unsigned long long)index * BITS;
+		const unsigned long long* data = words.Data();
+		const arrint word = arrint(bit >> 6);
+		const unsigned int shift = (unsigned int)(bit & 63);
+		unsigned long long value = data[word] >> shift;
+		if (shift + BITS > 64) {
+			value |= data[word + 1] << (64 - shift);
+		}
+		return Bittype(value & VALUE_MASK);
+	}
+
+	constexpr void Write(arrint index, unsigned long long value) {
+		value &= VALUE_MASK;
+		const unsigned long long bit = (unsigned long long)index * BITS;
+		unsigned long long* data = words.Data();
+		const arrint word = arrint(bit >> 6);
+		const unsigned int shift = (unsigned int)(bit & 63);
+		data[word] = (data[word] & ~(VALUE_MASK << shift)) | (value << shift);
+		if (shift + BITS > 64) {
+			const unsigned int highBits = shift + BITS - 64;
+			const unsigned long long highMask = (1ULL << highBits) - 1;
+			data[word + 1] = (data[word + 1] & ~highMask) | (value >> (64 - shift));
+		}
+	}
+
+#if defined(__AVX2__)
+
+	/* Decodes 8 values starting at first. Each value is gathered as the 32 bits starting at its first byte, then shifted down and masked,
+	which is why BITS plus the bit offset within the byte must fit in 32 bits. */
+	void Unpack8(arrint first, Bittype* out) const {
+		static_assert(BITS <= 25, "packed_darray AVX2 decoding requires at most 25 bits per value");
+		const unsigned long long bit = (unsigned long long)first * BITS;
+		const unsigned char* bytes = (const unsigned char*)words.Data() + (bit >> 3);
+		const __m256i offsets = _mm256_add_epi32(
+			_mm256_set1_epi32((int)(bit & 7)),
+			_mm256_setr_epi32(0, BITS, 2 * BITS, 3 * BITS, 4 * BITS, 5 * BITS, 6 * BITS, 7 * BITS));
+		const __m256i gathered = _mm256_i32gather_epi32((const int*)bytes, _mm256_srli_epi32(offsets, 3), 1);
+		const __m256i shifted = _mm256_srlv_epi32(gathered, _mm256_and_si256(offsets, _mm256_set1_epi32(7)));
+		const __m256i values = _mm256_and_si256(shifted, _mm256_set1_epi32((int)VALUE_MASK));
+		if constexpr (sizeof(Bittype) == 4) {
+			_mm256_storeu_si256((__m256i*)out, values);
+		}
+		else {
+			alignas(32) unsigned int decoded[8];
+			_mm256_store_si256((__m256i*)decoded, values);
+			for (int i = 0; i < 8; i++) {
+				out[i] = Bittype(decoded[i]);
+			}
+		}
+	}
+
+#endif
+
+public:
+
+	constexpr packed_darray()
+		: words(), size(0)
+	{
+		words.Add(0);
+	}
+
+	/* @return The number of values currently held in the array. */
+	[[nodiscard]] constexpr arrint Size() const {
+		return size;
+	}
+
+	/* @return The number of values the allocated words can hold. */
+	[[nodiscard]] constexpr arrint Capacity() const {
+		return arrint((unsigned long long)(words.Capacity() - 1) * 64 / BITS);
+	}
+
+	[[nodiscard]] constexpr bool IsEmpty() const {
+		return size == 0;
+	}
+
+	/* @return The number of 64 bit words holding the values, including the padding word. */
+	[[nodiscard]] constexpr arrint WordCount() const {
+		return words.Size();
+	}
+
+	[[nodiscard]] constexpr Bittype Get(arrint index) const {
+		bounds_check::Index(index, size, "Packed array Get() index is out of bounds!");
+		return Read(index);
+	}
+
+	[[nodiscard]] constexpr Bittype operator [] (arrint index) const {
+		return Get(index);
+	}
+
+	constexpr void Set(arrint index, Bittype value) {
+		bounds_check::Index(index, size, "Packed array Set() index is out of bounds!");
+		Write(index, value);
+	}
+
+	constexpr void Add(Bittype value) {
+		EnsureWords(size + 1);
+		Write(size, value);
+		size++;
+	}
+
+	/* Allocates words for at least newCapacity values. If the new capacity is not more than the current capacity, this function does nothing. */
+	constexpr void Reserve(arrint newCapacity) {
+		if (newCapacity <= Capacity()) return;
+		words.Reserve(WordsFor(newCapacity));
+	}
+
+	/* Removes every value, keeping the allocation. */
+	constexpr void Clear() {
+		words.Clear();
+		words.Add(0);
+		size = 0;
+	}
+
+	/* Adds count values to the end. Builds each word in a register and writes it once, rather than a read, modify and write per value. */
+	constexpr void Pack(const Bittype* values, arrint count) {
+		if (count == 0) return;
+		EnsureWords(size + count);
+		const unsigned long long bit = (unsigned long long)size * BITS;
+		unsigned long long* data = words.Data();
+		arrint word = arrint(bit >> 6);
+		unsigned int shift = (unsigned int)(bit & 63);
+		unsigned long long current = shift == 0 ? 0 : data[word] & ((1ULL << shift) - 1);
+		for (arrint i = 0; i < count; i++) {
+			const unsigned long long value = (unsigned long long)values[i] & VALUE_MASK;
+			current |= value << shift;
+			shift += BITS;
+			if (shift >= 64) {
+				data[word] = current;
+				word++;
+				shift -= 64;
+				current = shift == 0 ? 0 : value >> (BITS - shift);
+			}
+		}
+		data[word] = current;
+		size += count;
+	}
+
+	/* Decodes count values starting at first into out.
+	@param out: Must hold count values. */
+	constexpr void Unpack(arrint first, arrint count, Bittype* out) const {
+		if ((unsigned long long)first + count > size) {
+			throw std::out_of_range("Packed array Unpack() range is out of bounds!");
+		}
+		arrint i = 0;
+#if defined(__AVX2__)
+		if constexpr (BITS <= 25) {
+			if (!std::is_constant_evaluated()) {
+				for (; i + 8 <= count; i += 8) {
+					Unpack8(first + i, out + i);
+				}
+			}
+		}
+#endif
+		for (; i < count; i++) {
+			out[i] = Read(first + i);
+		}
+	}
+
+	/* Calls func(Bittype value) for every value in order, decoding DECODE_BLOCK values per step. */
+	template<typename Func>
+	constexpr void ForEach(Func&& func) const {
+		Bittype block[DECODE_BLOCK] = {};
+		for (arrint first = 0; first < size; first += DECODE_BLOCK) {
+			const arrint count = size - first < DECODE_BLOCK ? size - first : DECODE_BLOCK;
+			Unpack(first, count, block);
+			for (arrint i = 0; i < count; i++) {
+				func(block[i]);
+			}
+		}
+	}
+
+};
@@ -0,0 +1,125 @@
+#include "packed_darray.h"
+
+#define TEST_TYPES "Packed Dynamic Array"
+#include <testframework/unit_test_compile_time.h>
+
+namespace PackedDynamicArrayUnitTests
+{
+
+#pragma region Class
+
+	static_assert(std::is_same_v<packed_darray<3>::Bittype, unsigned char>, "packed_darray<3> does not use unsigned char values");
+	static_assert(std::is_same_v<packed_darray<12>::Bittype, unsigned short>, "packed_darray<12> does not use unsigned short values");
+	static_assert(std::is_same_v<packed_darray<64>::Bittype, unsigned long long>, "packed_darray<64> does not use unsigned long long values");
+
+#pragma endregion
+
+#pragma region Get_Set
+
+	constexpr bool DefaultEmpty() {
+		packed_darray<5> arr;
+		return arr.IsEmpty() && arr.Size() == 0 && arr.WordCount() == 1;
+	}
+	TEST_ASSERT(DefaultEmpty(), "Default packed array is not empty");
+
+	constexpr bool AddGet() {
+		packed_darray<3> arr;
+		for (arrint i = 0; i < 100; i++) {
+			arr.Add((unsigned char)(i % 8));
+		}
+		for (arrint i = 0; i < 100; i++) {
+			if (arr.Get(i) != i % 8) return false;
+		}
+		return arr.Size() == 100 && arr.WordCount() == 6;
+	}
+	TEST_ASSERT(AddGet(), "Packed array Add() and Get() values are incorrect");
+
+	constexpr bool AcrossWords() {
+		packed_darray<12> arr;
+		for (arrint i = 0; i < 50; i++) {
+			arr.Add((unsigned short)(4095 - i * 7));
+		}
+		// Value 5 occupies bits 60 to 71, spanning the first two words.
+		for (arrint i = 0; i < 50; i++) {
+			if (arr[i] != 4095 - i * 7) return false;
+		}
+		return true;
+	}
+	TEST_ASSERT(AcrossWords(), "Packed array values spanning two words are incorrect");
+
+	constexpr bool SetKeepsNeighbours() {
+		packed_darray<7> arr;
+		for (arrint i = 0; i < 20; i++) {
+			arr.Add(127);
+		}
+		arr.Set(9, 0);
+		return arr.Get(8) == 127 && arr.Get(9) == 0 && arr.Get(10) == 127;
+	}
+	TEST_ASSERT(SetKeepsNeighbours(), "Packed array Set() changes neighbouring values");
+
+	constexpr bool TruncatesWideValues() {
+		packed_darray<4> arr;
+		arr.Add(0xFF);
+		arr.Add(1);
+		return arr.Get(0) == 0xF && arr.Get(1) == 1;
+	}
+	TEST_ASSERT(TruncatesWideValues(), "Packed array does not truncate values wider than the bit count");
+
+	constexpr bool FullWidth() {
+		packed_darray<64> arr;
+		arr.Add(~0ULL);
+		arr.Add(12345);
+		return arr.Get(0) == ~0ULL && arr.Get(1) == 12345;
+	}
+	TEST_ASSERT(FullWidth(), "Packed array of 64 bit values is incorrect");
+
+	constexpr bool ClearResets() {
+		packed_darray<9> arr;
+		for (arrint i = 0; i < 30; i++) {
+			arr.Add(511);
+		}
+		arr.Clear();
+		arr.Add(1);
+		return arr.Size() == 1 && arr.Get(0) == 1;
+	}
+	TEST_ASSERT(ClearResets(), "Packed array Clear() does not reset values");
+
+#pragma endregion
+
+#pragma region Bulk
+
+	constexpr bool PackUnpack() {
+		unsigned short values[100] = {};
+		for (arrint i = 0; i < 100; i++) {
+			values[i] = (unsigned short)((i * 37) % 1024);
+		}
+		packed_darray<10> arr;
+		arr.Add(3);
+		arr.Pack(values, 100);
+		unsigned short out[100] = {};
+		arr.Unpack(1, 100, out);
+		for (arrint i = 0; i < 100; i++) {
+			if (out[i] != values[i]) return false;
+		}
+		return arr.Size() == 101 && arr.Get(0) == 3;
+	}
+	TEST_ASSERT(PackUnpack(), "Packed array Pack() and Unpack() values are incorrect");
+
+	constexpr bool ForEachInOrder() {
+		packed_darray<6> arr;
+		for (arrint i = 0; i < 37; i++) {
+			arr.Add((unsigned char)i);
+		}
+		arrint expected = 0;
+		bool ordered = true;
+		arr.ForEach([&](unsigned char value) {
+			ordered = ordered && value == expected;
+			expected++;
+		});
+		return ordered && expected == 37;
+	}
+	TEST_ASSERT(ForEachInOrder(), "Packed array ForEach() does not visit every value in order");
+
+#pragma endregion
+
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "dynamic_array.h"
+#include <bit>
+
+/* A double ended queue stored in a single circular allocation. Adding and removing at either end is O(1).
+The capacity is always a power of two, so wrapping an index is a mask instead of a division. When full, the capacity doubles
+and the elements are moved to the start of the new allocation in order. Throws std::out_of_range when popping or accessing the front or back of an empty array. */
+template<typename T>
+struct ring_darray
+{
+private:
+
+	T* data;
+	arrint head;
+	arrint size;
+	arrint capacity;
+
+public:
+
+	static constexpr arrint DEFAULT_CAPACITY = 4;
+
+	/* @return The number of elements currently held in the array. */
+	constexpr arrint Size() const {
+		return size;
+	}
+
+	/* @return The capacity of the allocated data. Always a power of two. */
+	constexpr arrint Capacity() const {
+		return capacity;
+	}
+
+	constexpr bool IsEmpty() const {
+		return size == 0;
+	}
+
+private:
+
+	constexpr arrint Wrap(arrint index) const {
+		return index & (capacity - 1);
+	}
+
+	/* Moves every element into a new allocation in order, unwrapping the buffer so the head is at index 0. */
+	constexpr void Reallocate(arrint newCapacity) {
+		T* newData = new T[newCapacity];
+		alloc_tracker<ring_darray<T>>::RecordReallocation(sizeof(T) * newCapacity);
+		for (arrint i = 0; i < size; i++) {
+			newData[i] = std::move(data[Wrap(head + i)]);
+		}
+		delete[] data;
+		data = newData;
+		head = 0;
+		capacity = newCapacity;
+	}
+
+	constexpr void GrowIfFull() {
+		if (size == capacity) {
+			Reallocate(capacity * 2);
+		}
+	}
+
+	constexpr void ThrowIfEmpty() const {
+		if (size == 0) {
+			throw std::out_of_range("Ring array is empty!");
+		}
+	}
+
+public:
+
+	constexpr ring_darray() {
+		data = new T[DEFAULT_CAPACITY];
+		alloc_tracker<ring_darray<T>>::RecordAllocation(sizeof(T) * DEFAULT_CAPACITY);
+		head = 0;
+		size = 0;
+		capacity = DEFAULT_CAPACITY;
+	}
+
+	/* Copies every element in order into a new allocation of the same capacity. */
+	constexpr ring_darray(const ring_darray<T>& other) {
+		data = new T[other.capacity];
+		alloc_tracker<ring_darray<T>>::RecordAllocation(sizeof(T) * other.capacity);
+		head = 0;
+		size = other.size;
+		capacity = other.capacity;
+		for (arrint i = 0; i < size; i++) {
+			data[i] = other.data[other.Wrap(other.head + i)];
+		}
+	}
+
+	/* Takes the other array's data. The other array is left empty with no allocation, and allocates again when pushed to. */
+	constexpr ring_darray(ring_darray<T>&& other) noexcept {
+		data = other.data;
+		head = other.head;
+		size = other.size;
+		capacity = other.capacity;
+		other.data = nullptr;
+		other.head = 0;
+		other.size = 0;
+		other.capacity = 0;
+	}
+
+	constexpr ~ring_darray() {
+		if (data != nullptr)
+			delete[] data;
+	}
+
+	constexpr ring_darray<T>& operator = (const ring_darray<T>& other) {
+		if (this == &other) return *this;
+
+		T* newData = new T[other.capacity];
+		alloc_tracker<ring_darray<T>>::RecordAllocation(sizeof(T) * other.capacity);
+		for (arrint i = 0; i < other.size; i++) {
+			newData[i] = other.data[other.Wrap(other.head + i)];
+		}
+		if (data != nullptr)
+			delete[] data;
+		data = newData;
+		head = 0;
+		size = other.size;
+		capacity = other.capacity;
+		return *this;
+	}
+
+	constexpr ring_darray<T>& operator = (ring_darray<T>&& other) noexcept {
+		if (this == &other) return *this;
+
+		if (data != nullptr)
+			delete[] data;
+		data = other.data;
+		head = other.head;
+		size = other.size;
+		capacity = other.capacity;
+		other.data = nullptr;
+		other.head = 0;
+		other.size = 0;
+		other.capacity = 0;
+		return *this;
+	}
+
+	/* Grows the capacity to hold at least newCapacity elements, rounded up to a power of two. If the new capacity is not more than the current capacity, this function does nothing. */
+	constexpr void Reserve(arrint newCapacity) {
+		if (newCapacity <= capacity) return;
+		Reallocate(std::bit_ceil(newCapacity));
+	}
+
+	/* Get an element by its position from the front. Bounds checked according to CONTAINER_CHECK_POLICY. */
+	constexpr T& At(arrint index) {
+		bounds_check::Index(index, size, "Ring array element At() index is out of bounds!");
+		return data[Wrap(head + index)];
+	}
+
+	constexpr const T& At(arrint index) const {
+		bounds_check::Index(index, size, "Ring array element At() index is out of bounds!");
+		return data[Wrap(head + index)];
+	}
+
+	constexpr T& operator [] (arrint index) {
+		return At(index);
+	}
+
+	constexpr const T& operator [] (arrint index) const {
+		return At(index);
+	}
+
+	constexpr T& Front() {
+		ThrowIfEmpty();
+		return data[head];
+	}
+
+	constexpr T& Back() {
+		ThrowIfEmpty();
+		return data[Wrap(head + size - 1)];
+	}
+
+	constexpr void PushBack(T&& element) {
+		if (capacity == 0) Reallocate(DEFAULT_CAPACITY);
+		GrowIfFull();
+		data[Wrap(head + size)] = std::move(element);
+		size++;
+	}
+
+	constexpr void PushBack(const T& element) {
+		if (capacity == 0) Reallocate(DEFAULT_CAPACITY);
+		GrowIfFull();
+		data[Wrap(head + size)] = element;
+		size++;
+	}
+
+	constexpr void PushFront(T&& element) {
+		if (capacity == 0) Reallocate(DEFAULT_CAPACITY);
+		GrowIfFull();
+		head = Wrap(head - 1);
+		data[head] = std::move(element);
+		size++;
+	}
+
+	constexpr void PushFront(const T& element) {
+		if (capacity == 0) Reallocate(DEFAULT_CAPACITY);
+		GrowIfFull();
+		head = Wrap(head - 1);
+		data[head] = element;
+		size++;
+	}
+
+	/* Removes and returns the front element. */
+	constexpr T PopFront() {
+		ThrowIfEmpty();
+		T element = std::move(data[head]);
+		head = Wrap(head + 1);
+		size--;
+		return element;
+	}
+
+	/* Removes and returns the back element. */
+	constexpr T PopBack() {
+		ThrowIfEmpty();
+		size--;
+		return std::move(data[Wrap(head + size)]);
+	}
+
+	/* Removes every element, keeping the allocation. */
+	constexpr void Clear() {
+		while (size > 0) {
+			(void)PopBack();
+		}
+		head = 0;
+	}
+
+};
@@ -0,0 +1,135 @@
+#include "ring_darray.h"
+
+#define TEST_TYPES "Ring Dynamic Array"
+#include <testframework/unit_test_compile_time.h>
+
+#include "../string/string.h"
+
+namespace RingDynamicArrayUnitTests
+{
+
+#pragma region Class
+
+	static_assert(sizeof(ring_darray<int>) == 24, "Size of ring_darray with T = int is not 24 bytes");
+
+#pragma endregion
+
+#pragma region Push_Pop
+
+	constexpr bool DefaultEmpty() {
+		ring_darray<int> arr;
+		return arr.IsEmpty() && arr.Size() == 0 && arr.Capacity() == ring_darray<int>::DEFAULT_CAPACITY;
+	}
+	TEST_ASSERT(DefaultEmpty(), "Default ring array is not empty");
+
+	constexpr bool PushBackPopFrontFifo() {
+		ring_darray<int> arr;
+		for (int i = 0; i < 10; i++) {
+			arr.PushBack(i);
+		}
+		for (int i = 0; i < 10; i++) {
+			if (arr.PopFront() != i) return false;
+		}
+		return arr.IsEmpty();
+	}
+	TEST_ASSERT(PushBackPopFrontFifo(), "Ring array PushBack() and PopFront() is not first in first out");
+
+	constexpr bool PushFrontPopFrontLifo() {
+		ring_darray<int> arr;
+		for (int i = 0; i < 10; i++) {
+			arr.PushFront(i);
+		}
+		for (int i = 9; i >= 0; i--) {
+			if (arr.PopFront() != i) return false;
+		}
+		return arr.IsEmpty();
+	}
+	TEST_ASSERT(PushFrontPopFrontLifo(), "Ring array PushFront() and PopFront() is not last in first out");
+
+	constexpr bool PopBack() {
+		ring_darray<int> arr;
+		arr.PushBack(1);
+		arr.PushBack(2);
+		arr.PushFront(0);
+		return arr.PopBack() == 2 && arr.PopBack() == 1 && arr.PopBack() == 0 && arr.IsEmpty();
+	}
+	TEST_ASSERT(PopBack(), "Ring array PopBack() does not remove from the back");
+
+	constexpr bool FrontBack() {
+		ring_darray<int> arr;
+		arr.PushBack(5);
+		arr.PushFront(3);
+		arr.PushBack(7);
+		return arr.Front() == 3 && arr.Back() == 7 && arr[1] == 5;
+	}
+	TEST_ASSERT(FrontBack(), "Ring array Front(), Back(), or index access is incorrect");
+
+#pragma endregion
+
+#pragma region Growth
+
+	constexpr bool GrowWhileWrapped() {
+		ring_darray<int> arr;
+		// Move the head so the elements wrap around the end of the allocation before growing.
+		for (int i = 0; i < 3; i++) {
+			arr.PushBack(-1);
+		}
+		for (int i = 0; i < 3; i++) {
+			(void)arr.PopFront();
+		}
+		for (int i = 0; i < 20; i++) {
+			arr.PushBack(i);
+		}
+		if (arr.Capacity() != 32) return false;
+		for (arrint i = 0; i < 20; i++) {
+			if (arr[i] != int(i)) return false;
+		}
+		return true;
+	}
+	TEST_ASSERT(GrowWhileWrapped(), "Ring array growth does not keep the elements in order when wrapped");
+
+	constexpr bool ReservePowerOfTwo() {
+		ring_darray<int> arr;
+		arr.Reserve(100);
+		return arr.Capacity() == 128;
+	}
+	TEST_ASSERT(ReservePowerOfTwo(), "Ring array Reserve() does not round up to a power of two");
+
+	constexpr bool StringElements() {
+		ring_darray<string> arr;
+		for (int i = 0; i < 10; i++) {
+			arr.PushBack(string("a string long enough to need a heap allocation"));
+			arr.PushFront(string("short"));
+		}
+		string front = arr.PopFront();
+		string back = arr.PopBack();
+		return front == "short" && back == "a string long enough to need a heap allocation" && arr.Size() == 18;
+	}
+	TEST_ASSERT(StringElements(), "Ring array of strings is incorrect");
+
+#pragma endregion
+
+#pragma region Copy_Move
+
+	constexpr bool CopyUnwraps() {
+		ring_darray<int> arr;
+		arr.PushBack(2);
+		arr.PushFront(1);
+		arr.PushFront(0);
+		ring_darray<int> copy = arr;
+		return copy.Size() == 3 && copy[0] == 0 && copy[1] == 1 && copy[2] == 2 && arr.Size() == 3;
+	}
+	TEST_ASSERT(CopyUnwraps(), "Ring array copy does not hold the same elements in order");
+
+	constexpr bool MoveThenPush() {
+		ring_darray<int> arr;
+		arr.PushBack(1);
+		ring_darray<int> moved = std::move(arr);
+		arr.PushBack(2);
+		return moved.Size() == 1 && moved[0] == 1 && arr.Size() == 1 && arr[0] == 2;
+	}
+	TEST_ASSERT(MoveThenPush(), "Ring array move does not leave a usable empty array");
+
+#pragma endregion
+
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <utility>
+
+#define _SPSC_CACHE_LINE_SIZE 64
+
+/* A fixed capacity, lock free queue for passing elements from exactly one producer thread to exactly one consumer thread.
+The head and tail indices are on separate cache lines, so the producer and consumer don't invalidate each other's line on every operation.
+Each side also caches the other side's index, and only reloads it when the queue looks full or empty. Never allocates. Not constexpr valid.
+@param T: Element type. Must be default constructible and move assignable.
+@param CAPACITY: Maximum number of elements. Must be a power of two. */
+template<typename T, size_t CAPACITY>
+struct spsc_ring
+{
+	static_assert(std::has_single_bit(CAPACITY), "spsc_ring capacity must be a power of two");
+
+private:
+
+	/* Next index the consumer will pop. Written by the consumer only. */
+	alignas(_SPSC_CACHE_LINE_SIZE) std::atomic<size_t> head;
+
+	/* Consumer's last seen value of tail. */
+	size_t cachedTail;
+
+	/* Next index the producer will push. Written by the producer only. */
+	alignas(_SPSC_CACHE_LINE_SIZE) std::atomic<size_t> tail;
+
+	/* Producer's last seen value of head. */
+	size_t cachedHead;
+
+	alignas(_SPSC_CACHE_LINE_SIZE) T elements[CAPACITY];
+
+	static constexpr size_t Wrap(size_t index) {
+		return index & (CAPACITY - 1);
+	}
+
+	/* Producer side check for room, reloading the consumer's head only when the cached value says the queue is full. */
+	bool HasRoom(size_t currentTail) {
+		if (currentTail - cachedHead < CAPACITY) return true;
+		cachedHead = head.load(std::memory_order_acquire);
+		return currentTail - cachedHead < CAPACITY;
+	}
+
+public:
+
+	spsc_ring()
+		: head(0), cachedTail(0), tail(0), cachedHead(0), elements{}
+	{}
+
+	spsc_ring(const spsc_ring&) = delete;
+
+	spsc_ring& operator = (const spsc_ring&) = delete;
+
+	/* Get the maximum number of elements. */
+	static constexpr size_t Capacity() {
+		return CAPACITY;
+	}
+
+	/* Producer only. Adds an element to the back of the queue.
+	@return If there was room for the element. */
+	bool TryPush(const T& element) {
+		const size_t currentTail = tail.load(std::memory_order_relaxed);
+		if (!HasRoom(currentTail)) return false;
+		elements[Wrap(currentTail)] = element;
+		tail.store(currentTail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/* Producer only. Adds an element to the back of the queue. The element is only moved from if there was room.
+	@return If there was room for the element. */
+	bool TryPush(T&& element) {
+		const size_t currentTail = tail.load(std::memory_order_relaxed);
+		if (!HasRoom(currentTail)) return false;
+		elements[Wrap(currentTail)] = std::move(element);
+		tail.store(currentTail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/* Consumer only. Removes the element at the front of the queue.
+	@param out: Assigned the removed element.
+	@return If there was an element to remove. */
+	bool TryPop(T& out) {
+		const size_t currentHead = head.load(std::memory_order_relaxed);
+		if (currentHead == cachedTail) {
+			cachedTail = tail.load(std::memory_order_acquire);
+			if (currentHead == cachedTail) return false;
+		}
+		out = std::move(elements[Wrap(currentHead)]);
+		head.store(currentHead + 1, std::memory_order_release);
+		return true;
+	}
+
+	/* Get the number of elements in the queue. Only exact when called while neither side is operating. */
+	size_t SizeApprox() const {
+		// Head first, as it can never pass a tail loaded after it.
+		const size_t currentHead = head.load(std::memory_order_acquire);
+		const size_t currentTail = tail.load(std::memory_order_acquire);
+		return currentTail - currentHead;
+	}
+
+	bool IsEmptyApprox() const {
+		return SizeApprox() == 0;
+	}
+
+};
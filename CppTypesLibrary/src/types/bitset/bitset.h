@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../diagnostics/bounds_checking.h"
 #include <type_traits>
 
 /* A more size compressed version of std::bitset. Supports bit amounts from 1-64. */
@@ -31,10 +32,13 @@ struct bitset
 		bits = other.bits;
 	}
 
+	/* Bounds checked according to CONTAINER_CHECK_POLICY. */
 	constexpr bool GetBit(size_t index) {
+		bounds_check::Index(index, bitCount, "Bitset GetBit() index is out of bounds!");
 		return bits >> index & 1U;
 	}
 
+	/* Same as GetBit(). */
 	constexpr bool operator [] (size_t index) {
 		return GetBit(index);
 	}
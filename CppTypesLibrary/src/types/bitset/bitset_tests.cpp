@@ -67,6 +67,29 @@ namespace BitsetUnitTests
 	}
 	TEST_ASSERT(GetBitOperator(), "Getting a bitflag from operator[] does not get the correct flag");
 
+	constexpr bool GetBitLast() {
+		bitset<64> bit = 1ULL << 63;
+		return bit.GetBit(63) && bit[63];
+	}
+
+	constexpr bool GetBitOutOfRange() {
+		bitset<64> bit = ~0ULL;
+		return bit.GetBit(64);
+	}
+
+	constexpr bool GetBitOperatorOutOfRange() {
+		bitset<8> bit = 0xFF;
+		return bit[8];
+	}
+
+	/* Out of bounds access must stay checked during constant evaluation whatever the CONTAINER_CHECK_POLICY, which makes the call non constant. */
+	template<bool (*FUNC)()>
+	constexpr bool IsConstant() {
+		return requires { typename std::bool_constant<FUNC()>; };
+	}
+	TEST_ASSERT(IsConstant<GetBitLast>() && !IsConstant<GetBitOutOfRange>() && !IsConstant<GetBitOperatorOutOfRange>(),
+		"Getting a bitflag out of bounds is not checked during constant evaluation");
+
 #pragma endregion
 
 #pragma region Set_Flag
@@ -0,0 +1,91 @@
+#include "bloom_filter.h"
+
+#define TEST_TYPES "Bloom Filter"
+#include <testframework/unit_test_compile_time.h>
+
+namespace BloomFilterUnitTests
+{
+
+#pragma region Class
+
+	static_assert(sizeof(bloom_block) == 64 && alignof(bloom_block) == 64, "Bloom filter block is not exactly one cache line");
+
+	constexpr bool SizedForKeys() {
+		blocked_bloom_filter small(0);
+		blocked_bloom_filter large(1000, 16);
+		return small.BlockCount() == 1 && large.BlockCount() == 32;
+	}
+	TEST_ASSERT(SizedForKeys(), "Bloom filter block count is not sized for the expected keys");
+
+#pragma endregion
+
+#pragma region Add_Query
+
+	constexpr bool NoFalseNegatives() {
+		blocked_bloom_filter filter(200);
+		for (unsigned int i = 0; i < 200; i++) {
+			filter.Add(string::From(i));
+		}
+		for (unsigned int i = 0; i < 200; i++) {
+			if (!filter.MayContain(string::From(i))) return false;
+		}
+		return true;
+	}
+	TEST_ASSERT(NoFalseNegatives(), "Bloom filter reports an added key as absent");
+
+	constexpr bool FewFalsePositives() {
+		blocked_bloom_filter filter(200);
+		for (unsigned int i = 0; i < 200; i++) {
+			filter.Add(string::From(i));
+		}
+		int falsePositives = 0;
+		for (unsigned int i = 1000; i < 3000; i++) {
+			if (filter.MayContain(string::From(i))) falsePositives++;
+		}
+		return falsePositives < 40;
+	}
+	TEST_ASSERT(FewFalsePositives(), "Bloom filter reports too many absent keys as present");
+
+	constexpr bool HashMatchesString() {
+		blocked_bloom_filter filter(10);
+		filter.Add("key", 3);
+		string longKey = "a key long enough to need a heap allocation";
+		filter.Add(longKey.Hash());
+		return filter.MayContain(string("key")) && filter.MayContain("a key long enough to need a heap allocation", 43);
+	}
+	TEST_ASSERT(HashMatchesString(), "Bloom filter does not hash characters the same as buffer_string");
+
+	constexpr bool ClearEmpties() {
+		blocked_bloom_filter filter(10);
+		filter.Add(string("key"));
+		filter.Clear();
+		return !filter.MayContain(string("key"));
+	}
+	TEST_ASSERT(ClearEmpties(), "Bloom filter Clear() does not remove keys");
+
+#pragma endregion
+
+#pragma region Batch
+
+	constexpr bool MayContainManyMatches() {
+		blocked_bloom_filter filter(64);
+		string keys[32];
+		for (unsigned int i = 0; i < 32; i++) {
+			keys[i] = string::From(i * 7);
+			if (i % 2 == 0) {
+				filter.Add(keys[i]);
+			}
+		}
+		bool results[32];
+		filter.MayContainMany(keys, 32, results);
+		for (unsigned int i = 0; i < 32; i++) {
+			if (results[i] != filter.MayContain(keys[i])) return false;
+			if (i % 2 == 0 && !results[i]) return false;
+		}
+		return true;
+	}
+	TEST_ASSERT(MayContainManyMatches(), "Bloom filter MayContainMany() does not match MayContain()");
+
+#pragma endregion
+
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "bitset.h"
+#include <bit>
+
+/* Number of flags an enum_bitset of Enum holds. Enum must end with a Count enumerator, and every other enumerator must be a bit index below it. */
+template<typename Enum>
+constexpr size_t enum_bit_count = (size_t)Enum::Count;
+
+/* A combination of enumerators of Enum as a single bit mask, built with operator | at compile time. See ENUM_BITSET_OPERATORS. */
+template<typename Enum>
+struct enum_mask
+{
+	static_assert(std::is_enum_v<Enum>, "enum_mask type must be an enum");
+
+	typedef typename bitset<enum_bit_count<Enum>>::Bittype Bittype;
+
+	Bittype bits;
+
+	constexpr enum_mask()
+		: bits(0)
+	{}
+
+	constexpr enum_mask(Enum flag)
+		: bits(Bittype(Bittype(1) << (size_t)flag))
+	{}
+
+	[[nodiscard]] constexpr enum_mask operator | (enum_mask other) const {
+		enum_mask out;
+		out.bits = Bittype(bits | other.bits);
+		return out;
+	}
+
+	[[nodiscard]] constexpr bool operator == (const enum_mask& other) const = default;
+};
+
+/* Defines operator | for two enumerators of Enum, so they combine into an enum_mask. Use in the same namespace as Enum. */
+#define ENUM_BITSET_OPERATORS(Enum) \
+	[[nodiscard]] constexpr enum_mask<Enum> operator | (Enum a, Enum b) { return enum_mask<Enum>(a) | enum_mask<Enum>(b); }
+
+/* A set of flags indexed by the enumerators of Enum, stored in the smallest unsigned type that holds enum_bit_count<Enum> bits, the same as bitset.
+Testing a mask of several flags is a single and and compare. */
+template<typename Enum>
+struct enum_bitset
+{
+	static_assert(std::is_enum_v<Enum>, "enum_bitset type must be an enum");
+
+	typedef enum_mask<Enum> Mask;
+	typedef typename Mask::Bittype Bittype;
+
+private:
+
+	bitset<enum_bit_count<Enum>> flags;
+
+public:
+
+	constexpr enum_bitset()
+		: flags()
+	{}
+
+	constexpr enum_bitset(Mask mask)
+		: flags(mask.bits)
+	{}
+
+	constexpr enum_bitset(Enum flag)
+		: flags(Mask(flag).bits)
+	{}
+
+	/* @return The number of flags the set can hold. */
+	[[nodiscard]] constexpr static size_t GetBitCount() {
+		return enum_bit_count<Enum>;
+	}
+
+	/* @return The raw flag bits. */
+	[[nodiscard]] constexpr Bittype Bits() const {
+		return flags.bits;
+	}
+
+	/* @return If the flag is set. */
+	[[nodiscard]] constexpr bool Has(Enum flag) const {
+		return (flags.bits >> (size_t)flag & 1U) != 0;
+	}
+
+	/* @return If every flag in the mask is set. */
+	[[nodiscard]] constexpr bool Has(Mask mask) const {
+		return (flags.bits & mask.bits) == mask.bits;
+	}
+
+	/* @return If any flag in the mask is set. */
+	[[nodiscard]] constexpr bool HasAny(Mask mask) const {
+		return (flags.bits & mask.bits) != 0;
+	}
+
+	constexpr void Set(Enum flag, bool value = true) {
+		flags.SetBit((size_t)flag, value);
+	}
+
+	/* Sets every flag in the mask. */
+	constexpr void Set(Mask mask) {
+		flags.bits |= mask.bits;
+	}
+
+	/* Clears every flag in the mask. */
+	constexpr void Clear(Mask mask) {
+		flags.bits &= Bittype(~mask.bits);
+	}
+
+	constexpr void Clear(Enum flag) {
+		Clear(Mask(flag));
+	}
+
+	/* @return The number of set flags. */
+	[[nodiscard]] constexpr size_t Count() const {
+		return (size_t)std::popcount(flags.bits);
+	}
+
+	[[nodiscard]] constexpr bool IsEmpty() const {
+		return flags.bits == 0;
+	}
+
+	/* Calls func(Enum flag) for every set flag in ascending order. */
+	template<typename Func>
+	constexpr void ForEach(Func&& func) const {
+		Bittype remaining = flags.bits;
+		while (remaining != 0) {
+			func((Enum)std::countr_zero(remaining));
+			remaining = Bittype(remaining & (remaining - 1));
+		}
+	}
+
+	[[nodiscard]] constexpr enum_bitset operator | (enum_bitset other) const {
+		enum_bitset out;
+		out.flags.bits = Bittype(flags.bits | other.flags.bits);
+		return out;
+	}
+
+	[[nodiscard]] constexpr enum_bitset operator & (enum_bitset other) const {
+		enum_bitset out;
+		out.flags.bits = Bittype(flags.bits & other.flags.bits);
+		return out;
+	}
+
+	[[nodiscard]] constexpr bool operator == (const enum_bitset& other) const {
+		return flags.bits == other.flags.bits;
+	}
+
+};
@@ -0,0 +1,86 @@
+#include "enum_bitset.h"
+
+#define TEST_TYPES "Enum Bitset"
+#include <testframework/unit_test_compile_time.h>
+
+namespace EnumBitsetUnitTests
+{
+	enum class Permission
+	{
+		Read,
+		Write,
+		Execute,
+		Delete,
+		Count
+	};
+	ENUM_BITSET_OPERATORS(Permission)
+
+	enum class Wide
+	{
+		First = 0,
+		Last = 39,
+		Count
+	};
+
+#pragma region Class
+
+	static_assert(sizeof(enum_bitset<Permission>) == 1, "Size of enum_bitset with 4 flags is not 1 byte");
+	static_assert(sizeof(enum_bitset<Wide>) == 8, "Size of enum_bitset with 40 flags is not 8 bytes");
+	static_assert(enum_bitset<Permission>::GetBitCount() == 4, "enum_bitset bit count is not taken from the Count enumerator");
+
+#pragma endregion
+
+#pragma region Flags
+
+	constexpr bool SetHas() {
+		enum_bitset<Permission> flags;
+		flags.Set(Permission::Write);
+		return flags.Has(Permission::Write) && !flags.Has(Permission::Read) && flags.Count() == 1;
+	}
+	TEST_ASSERT(SetHas(), "Enum bitset Set() and Has() are incorrect");
+
+	constexpr bool HasMask() {
+		enum_bitset<Permission> flags = Permission::Read | Permission::Write;
+		return flags.Has(Permission::Read | Permission::Write) && !flags.Has(Permission::Write | Permission::Execute)
+			&& flags.HasAny(Permission::Write | Permission::Execute) && !flags.HasAny(Permission::Execute | Permission::Delete);
+	}
+	TEST_ASSERT(HasMask(), "Enum bitset mask Has() or HasAny() is incorrect");
+
+	constexpr bool ClearFlags() {
+		enum_bitset<Permission> flags = Permission::Read | Permission::Write | Permission::Delete;
+		flags.Clear(Permission::Write);
+		flags.Set(Permission::Delete, false);
+		return flags.Has(Permission::Read) && flags.Count() == 1;
+	}
+	TEST_ASSERT(ClearFlags(), "Enum bitset Clear() is incorrect");
+
+	constexpr bool WideFlags() {
+		enum_bitset<Wide> flags;
+		flags.Set(Wide::Last);
+		flags.Set(Wide::First);
+		return flags.Has(Wide::Last) && flags.Has(Wide::First) && flags.Bits() == ((1ULL << 39) | 1ULL);
+	}
+	TEST_ASSERT(WideFlags(), "Enum bitset with more than 32 flags is incorrect");
+
+	constexpr bool ForEachAscending() {
+		enum_bitset<Permission> flags = Permission::Delete | Permission::Read | Permission::Execute;
+		Permission visited[3] = {};
+		int count = 0;
+		flags.ForEach([&](Permission flag) {
+			visited[count] = flag;
+			count++;
+		});
+		return count == 3 && visited[0] == Permission::Read && visited[1] == Permission::Execute && visited[2] == Permission::Delete;
+	}
+	TEST_ASSERT(ForEachAscending(), "Enum bitset ForEach() does not visit set flags in ascending order");
+
+	constexpr bool Combine() {
+		enum_bitset<Permission> a = Permission::Read | Permission::Write;
+		enum_bitset<Permission> b = Permission::Write | Permission::Execute;
+		return (a & b) == enum_bitset<Permission>(Permission::Write) && (a | b).Count() == 3 && enum_bitset<Permission>().IsEmpty();
+	}
+	TEST_ASSERT(Combine(), "Enum bitset operators are incorrect");
+
+#pragma endregion
+
+}
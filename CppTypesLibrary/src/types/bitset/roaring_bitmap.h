@@ -0,0 +1,589 @@
+#pragma once
+
+#include "../array/dynamic_array.h"
+#include "../flat/flat_search.h"
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* The lower 16 bits of the values in one 65536 value chunk of a roaring_bitmap. Sparse chunks are a sorted array of values,
+and dense chunks are a 65536 bit bitmap. The representation switches at ARRAY_MAX values, where both use 8KB. */
+struct roaring_container
+{
+	/* Most values an array container holds. Past this, a bitmap is smaller. */
+	static constexpr unsigned int ARRAY_MAX = 4096;
+
+	/* Number of 64 bit words in a bitmap container. */
+	static constexpr unsigned int BITMAP_WORDS = 1024;
+
+private:
+
+	/* Sorted values, when this is an array container. */
+	darray<unsigned short> values;
+
+	/* BITMAP_WORDS words, when this is a bitmap container. */
+	darray<unsigned long long> words;
+
+	unsigned int cardinality;
+
+	bool isBitmap;
+
+	constexpr static darray<unsigned long long> ZeroWords() {
+		darray<unsigned long long> zeros;
+		zeros.Reserve(BITMAP_WORDS);
+		for (unsigned int i = 0; i < BITMAP_WORDS; i++) {
+			zeros.Add(0);
+		}
+		return zeros;
+	}
+
+	constexpr void ConvertToBitmap() {
+		darray<unsigned long long> bitmap = ZeroWords();
+		unsigned long long* bits = bitmap.Data();
+		for (arrint i = 0; i < values.Size(); i++) {
+			const unsigned short value = values.Data()[i];
+			bits[value >> 6] |= 1ULL << (value & 63);
+		}
+		words = std::move(bitmap);
+		values = darray<unsigned short>();
+		isBitmap = true;
+	}
+
+	constexpr void ConvertToArray() {
+		darray<unsigned short> array;
+		array.Reserve(cardinality);
+		ForEach([&array](unsigned short value) {
+			array.Add(value);
+		});
+		values = std::move(array);
+		words = darray<unsigned long long>();
+		isBitmap = false;
+	}
+
+	/* Converts a bitmap container that has become sparse back into an array container. */
+	constexpr void Shrink() {
+		if (isBitmap && cardinality <= ARRAY_MAX) {
+			ConvertToArray();
+		}
+	}
+
+	/* Builds a bitmap container from the AND or OR of two bitmap containers. Processes 4 words per step with AVX2 at runtime. */
+	template<bool IS_AND>
+	constexpr static roaring_container CombineBitmaps(const roaring_container& a, const roaring_container& b) {
+		roaring_container out;
+		out.words = ZeroWords();
+		out.isBitmap = true;
+		const unsigned long long* wordsA = a.words.Data();
+		const unsigned long long* wordsB = b.words.Data();
+		unsigned long long* wordsOut = out.words.Data();
+		unsigned int i = 0;
+#if defined(__AVX2__)
+		if (!std::is_constant_evaluated()) {
+			for (; i < BITMAP_WORDS; i += 4) {
+				const __m256i blockA = _mm256_loadu_si256((const __m256i*)(wordsA + i));
+				const __m256i blockB = _mm256_loadu_si256((const __m256i*)(wordsB + i));
+				_mm256_storeu_si256((__m256i*)(wordsOut + i), IS_AND ? _mm256_and_si256(blockA, blockB) : _mm256_or_si256(blockA, blockB));
+			}
+		}
+#endif
+		for (; i < BITMAP_WORDS; i++) {
+			wordsOut[i] = IS_AND ? (wordsA[i] & wordsB[i]) : (wordsA[i] | wordsB[i]);
+		}
+		unsigned int count = 0;
+		for (unsigned int w = 0; w < BITMAP_WORDS; w++) {
+			count += (unsigned int)std::popcount(wordsOut[w]);
+		}
+		out.cardinality = count;
+		out.Shrink();
+		return out;
+	}
+
+#if defined(__AVX2__)
+
+	/* Intersects two sorted arrays, comparing 16 values of a against 8 values of b per step. The block with the smaller last value moves on,
+	or both if their last values are equal, so every pair of equal values is in the current blocks at the same time exactly once.
+	@param out: Must hold the smaller of the two sizes.
+	@return The number of values written to out. */
+	static unsigned int IntersectArrays(const unsigned short* a, unsigned int sizeA, const unsigned short* b, unsigned int sizeB, unsigned short* out) {
+		unsigned int i = 0;
+		unsigned int j = 0;
+		unsigned int count = 0;
+		while (i + 16 <= sizeA && j + 8 <= sizeB) {
+			const __m256i blockA = _mm256_loadu_si256((const __m256i*)(a + i));
+			__m256i matches = _mm256_setzero_si256();
+			for (unsigned int k = 0; k < 8; k++) {
+				matches = _mm256_or_si256(matches, _mm256_cmpeq_epi16(blockA, _mm256_set1_epi16((short)b[j + k])));
+			}
+			// One bit per byte, so keep the low bit of each 16 bit lane.
+			unsigned int mask = (unsigned int)_mm256_movemask_epi8(matches) & 0x55555555u;
+			while (mask != 0) {
+				out[count] = a[i + ((unsigned int)std::countr_zero(mask) >> 1)];
+				count++;
+				mask &= mask - 1;
+			}
+			const unsigned short lastA = a[i + 15];
+			const unsigned short lastB = b[j + 7];
+			if (lastA <= lastB) i += 16;
+			if (lastB <= lastA) j += 8;
+		}
+		while (i < sizeA && j < sizeB) {
+			if (a[i] < b[j]) i++;
+			else if (b[j] < a[i]) j++;
+			else {
+				out[count] = a[i];
+				count++;
+				i++;
+				j++;
+			}
+		}
+		return count;
+	}
+
+	/* Merges two sorted vectors of 8 values, leaving the 8 smallest in low and the 8 largest in high, both sorted. */
+	static void MergeVectors(__m128i a, __m128i b, __m128i& low, __m128i& high) {
+		__m128i min = _mm_min_epu16(a, b);
+		__m128i max = _mm_max_epu16(a, b);
+		for (int k = 0; k < 7; k++) {
+			min = _mm_alignr_epi8(min, min, 2);
+			const __m128i nextMin = _mm_min_epu16(min, max);
+			max = _mm_max_epu16(min, max);
+			min = nextMin;
+		}
+		low = _mm_alignr_epi8(min, min, 2);
+		high = max;
+	}
+
+	/* Appends sorted values to out, skipping any equal to the value before them. */
+	static void AppendUnique(const unsigned short* sorted, unsigned int size, unsigned short* out, unsigned int& count) {
+		for (unsigned int k = 0; k < size; k++) {
+			out[count] = sorted[k];
+			count += (count == 0 || out[count - 1] != sorted[k]) ? 1 : 0;
+		}
+	}
+
+	/* Unions two sorted arrays by merging 8 values per step with a min/max merge network. The next 8 values come from whichever array has
+	the smaller next value, and the smallest 8 of those and the values left from the last step are output, as no later value can be smaller.
+	Both arrays hold each value at most once, so duplicates can only be adjacent in the output.
+	@param out: Must hold the sum of the two sizes.
+	@return The number of values written to out. */
+	static unsigned int UnionArrays(const unsigned short* a, unsigned int sizeA, const unsigned short* b, unsigned int sizeB, unsigned short* out) {
+		unsigned int i = 0;
+		unsigned int j = 0;
+		unsigned int count = 0;
+		alignas(16) unsigned short block[8];
+		unsigned int blockSize = 0;
+		if (sizeA >= 8 && sizeB >= 8) {
+			__m128i low;
+			__m128i high;
+			MergeVectors(_mm_loadu_si128((const __m128i*)a), _mm_loadu_si128((const __m128i*)b), low, high);
+			i = 8;
+			j = 8;
+			while (true) {
+				_mm_store_si128((__m128i*)block, low);
+				AppendUnique(block, 8, out, count);
+				const bool takeA = j == sizeB || (i < sizeA && a[i] <= b[j]);
+				if (takeA) {
+					if (i + 8 > sizeA) break;
+					MergeVectors(_mm_loadu_si128((const __m128i*)(a + i)), high, low, high);
+					i += 8;
+				}
+				else {
+					if (j + 8 > sizeB) break;
+					MergeVectors(_mm_loadu_si128((const __m128i*)(b + j)), high, low, high);
+					j += 8;
+				}
+			}
+			_mm_store_si128((__m128i*)block, high);
+			blockSize = 8;
+		}
+
+		// Finish the values left in the last block and both arrays with a scalar three way merge.
+		unsigned int k = 0;
+		while (k < blockSize || i < sizeA || j < sizeB) {
+			unsigned int value = 0x10000;
+			if (k < blockSize) value = block[k];
+			if (i < sizeA && a[i] < value) value = a[i];
+			if (j < sizeB && b[j] < value) value = b[j];
+			if (k < blockSize && block[k] == value) k++;
+			if (i < sizeA && a[i] == value) i++;
+			if (j < sizeB && b[j] == value) j++;
+			const unsigned short next = (unsigned short)value;
+			AppendUnique(&next, 1, out, count);
+		}
+		return count;
+	}
+
+#endif
+
+public:
+
+	constexpr roaring_container()
+		: values(), words(), cardinality(0), isBitmap(false)
+	{}
+
+	/* @return The number of values in this container. */
+	[[nodiscard]] constexpr unsigned int Cardinality() const {
+		return cardinality;
+	}
+
+	[[nodiscard]] constexpr bool IsBitmap() const {
+		return isBitmap;
+	}
+
+	[[nodiscard]] constexpr bool Contains(unsigned short value) const {
+		if (isBitmap) {
+			return (words.Data()[value >> 6] >> (value & 63) & 1ULL) != 0;
+		}
+		const arrint index = flat_search::LowerBound(values.Data(), values.Size(), value);
+		return index != values.Size() && values.Data()[index] == value;
+	}
+
+	/* @return If the value was not already in the container. */
+	constexpr bool Add(unsigned short value) {
+		if (isBitmap) {
+			unsigned long long& word = words.Data()[value >> 6];
+			const unsigned long long bit = 1ULL << (value & 63);
+			if (word & bit) return false;
+			word |= bit;
+			cardinality++;
+			return true;
+		}
+		const arrint index = flat_search::LowerBound(values.Data(), values.Size(), value);
+		if (index != values.Size() && values.Data()[index] == value) {
+			return false;
+		}
+		if (cardinality == ARRAY_MAX) {
+			ConvertToBitmap();
+			return Add(value);
+		}
+		values.Insert(index, value);
+		cardinality++;
+		return true;
+	}
+
+	/* @return If the value was in the container. */
+	constexpr bool Remove(unsigned short value) {
+		if (isBitmap) {
+			unsigned long long& word = words.Data()[value >> 6];
+			const unsigned long long bit = 1ULL << (value & 63);
+			if ((word & bit) == 0) return false;
+			word &= ~bit;
+			cardinality--;
+			Shrink();
+			return true;
+		}
+		const arrint index = flat_search::LowerBound(values.Data(), values.Size(), value);
+		if (index == values.Size() || values.Data()[index] != value) {
+			return false;
+		}
+		values.RemoveAt(index);
+		cardinality--;
+		return true;
+	}
+
+	/* Calls func(unsigned short value) for every value in ascending order. */
+	template<typename Func>
+	constexpr void ForEach(Func&& func) const {
+		if (!isBitmap) {
+			for (arrint i = 0; i < values.Size(); i++) {
+				func(values.Data()[i]);
+			}
+			return;
+		}
+		for (unsigned int w = 0; w < BITMAP_WORDS; w++) {
+			unsigned long long word = words.Data()[w];
+			while (word != 0) {
+				func((unsigned short)(w * 64 + (unsigned int)std::countr_zero(word)));
+				word &= word - 1;
+			}
+		}
+	}
+
+	/* @return A container of the values in both containers. */
+	[[nodiscard]] constexpr static roaring_container And(const roaring_container& a, const roaring_container& b) {
+		if (a.isBitmap && b.isBitmap) {
+			return CombineBitmaps<true>(a, b);
+		}
+		roaring_container out;
+		if (a.isBitmap || b.isBitmap) {
+			const roaring_container& array = a.isBitmap ? b : a;
+			const roaring_container& bitmap = a.isBitmap ? a : b;
+			for (arrint i = 0; i < array.values.Size(); i++) {
+				const unsigned short value = array.values.Data()[i];
+				if (bitmap.Contains(value)) {
+					out.values.Add(value);
+				}
+			}
+		}
+		else {
+			const unsigned short* valuesA = a.values.Data();
+			const unsigned short* valuesB = b.values.Data();
+#if defined(__AVX2__)
+			if (!std::is_constant_evaluated()) {
+				// Written straight into the reserved storage, then AddUninitialized() takes the written values as the array's size.
+				out.values.Reserve(a.values.Size() < b.values.Size() ? a.values.Size() : b.values.Size());
+				const unsigned int count = IntersectArrays(valuesA, a.values.Size(), valuesB, b.values.Size(), out.values.Data());
+				(void)out.values.AddUninitialized(count);
+				out.cardinality = count;
+				return out;
+			}
+#endif
+			arrint i = 0;
+			arrint j = 0;
+			while (i < a.values.Size() && j < b.values.Size()) {
+				if (valuesA[i] < valuesB[j]) i++;
+				else if (valuesB[j] < valuesA[i]) j++;
+				else {
+					out.values.Add(valuesA[i]);
+					i++;
+					j++;
+				}
+			}
+		}
+		out.cardinality = out.values.Size();
+		return out;
+	}
+
+	/* @return A container of the values in either container. */
+	[[nodiscard]] constexpr static roaring_container Or(const roaring_container& a, const roaring_container& b) {
+		if (a.isBitmap && b.isBitmap) {
+			return CombineBitmaps<false>(a, b);
+		}
+		if (a.isBitmap || b.isBitmap) {
+			const roaring_container& array = a.isBitmap ? b : a;
+			roaring_container out = a.isBitmap ? a : b;
+			for (arrint i = 0; i < array.values.Size(); i++) {
+				out.Add(array.values.Data()[i]);
+			}
+			return out;
+		}
+
+		roaring_container out;
+		out.values.Reserve(a.values.Size() + b.values.Size());
+		const unsigned short* valuesA = a.values.Data();
+		const unsigned short* valuesB = b.values.Data();
+#if defined(__AVX2__)
+		if (!std::is_constant_evaluated()) {
+			const unsigned int count = UnionArrays(valuesA, a.values.Size(), valuesB, b.values.Size(), out.values.Data());
+			(void)out.values.AddUninitialized(count);
+			out.cardinality = count;
+			if (out.cardinality > ARRAY_MAX) {
+				out.ConvertToBitmap();
+			}
+			return out;
+		}
+#endif
+		arrint i = 0;
+		arrint j = 0;
+		while (i < a.values.Size() && j < b.values.Size()) {
+			if (valuesA[i] < valuesB[j]) out.values.Add(valuesA[i++]);
+			else if (valuesB[j] < valuesA[i]) out.values.Add(valuesB[j++]);
+			else {
+				out.values.Add(valuesA[i]);
+				i++;
+				j++;
+			}
+		}
+		for (; i < a.values.Size(); i++) out.values.Add(valuesA[i]);
+		for (; j < b.values.Size(); j++) out.values.Add(valuesB[j]);
+		out.cardinality = out.values.Size();
+		if (out.cardinality > ARRAY_MAX) {
+			out.ConvertToBitmap();
+		}
+		return out;
+	}
+
+	/* @return The number of values in both containers, without building the intersection. */
+	[[nodiscard]] constexpr static unsigned int AndCardinality(const roaring_container& a, const roaring_container& b) {
+		if (a.isBitmap && b.isBitmap) {
+			unsigned int count = 0;
+			for (unsigned int w = 0; w < BITMAP_WORDS; w++) {
+				count += (unsigned int)std::popcount(a.words.Data()[w] & b.words.Data()[w]);
+			}
+			return count;
+		}
+		const roaring_container& array = a.isBitmap ? b : a;
+		const roaring_container& other = a.isBitmap ? a : b;
+		unsigned int count = 0;
+		for (arrint i = 0; i < array.values.Size(); i++) {
+			count += other.Contains(array.values.Data()[i]) ? 1 : 0;
+		}
+		return count;
+	}
+
+};
+
+/* A compressed set of 32 bit unsigned integers. Values are split by their upper 16 bits into chunks of 65536, and each chunk that holds any values
+is a roaring_container, which is a sorted array when sparse and a bitmap when dense. Millions of sparse values take a fraction of a dense bitset's memory,
+while dense ranges stay as fast as a bitset. Intersections and unions work chunk by chunk. With AVX2, bitmap chunks are combined 256 bits per step,
+sorted array chunks are intersected 16 by 8 values per step, and array chunks are unioned 8 values per step with a merge network.
+Cardinality is tracked per chunk, so Cardinality() never counts bits. */
+struct roaring_bitmap
+{
+private:
+
+	/* Upper 16 bits of each chunk, sorted. */
+	darray<unsigned short> keys;
+
+	/* Container of each chunk, in the same order as keys. */
+	darray<roaring_container> containers;
+
+	/* @return Index of the chunk with the key, or keys.Size() if there is none. */
+	[[nodiscard]] constexpr arrint FindChunk(unsigned short key) const {
+		const arrint index = flat_search::LowerBound(keys.Data(), keys.Size(), key);
+		if (index == keys.Size() || keys.Data()[index] != key) {
+			return keys.Size();
+		}
+		return index;
+	}
+
+	template<bool IS_AND>
+	[[nodiscard]] constexpr static roaring_bitmap Combine(const roaring_bitmap& a, const roaring_bitmap& b) {
+		roaring_bitmap out;
+		const unsigned short* keysA = a.keys.Data();
+		const unsigned short* keysB = b.keys.Data();
+		arrint i = 0;
+		arrint j = 0;
+		while (i < a.keys.Size() && j < b.keys.Size()) {
+			if (keysA[i] < keysB[j]) {
+				if (!IS_AND) out.AppendChunk(keysA[i], a.containers.Data()[i]);
+				i++;
+			}
+			else if (keysB[j] < keysA[i]) {
+				if (!IS_AND) out.AppendChunk(keysB[j], b.containers.Data()[j]);
+				j++;
+			}
+			else {
+				roaring_container combined;
+				if constexpr (IS_AND) {
+					combined = roaring_container::And(a.containers.Data()[i], b.containers.Data()[j]);
+				}
+				else {
+					combined = roaring_container::Or(a.containers.Data()[i], b.containers.Data()[j]);
+				}
+				if (combined.Cardinality() > 0) {
+					out.keys.Add(keysA[i]);
+					out.containers.Add(std::move(combined));
+				}
+				i++;
+				j++;
+			}
+		}
+		if (!IS_AND) {
+			for (; i < a.keys.Size(); i++) out.AppendChunk(keysA[i], a.containers.Data()[i]);
+			for (; j < b.keys.Size(); j++) out.AppendChunk(keysB[j], b.containers.Data()[j]);
+		}
+		return out;
+	}
+
+	constexpr void AppendChunk(unsigned short key, const roaring_container& container) {
+		keys.Add(key);
+		containers.Add(container);
+	}
+
+public:
+
+	constexpr roaring_bitmap() = default;
+
+	/* @return The number of values in the set. */
+	[[nodiscard]] constexpr unsigned long long Cardinality() const {
+		unsigned long long count = 0;
+		for (arrint i = 0; i < containers.Size(); i++) {
+			count += containers.Data()[i].Cardinality();
+		}
+		return count;
+	}
+
+	[[nodiscard]] constexpr bool IsEmpty() const {
+		return keys.Size() == 0;
+	}
+
+	/* @return The number of 65536 value chunks holding at least one value. */
+	[[nodiscard]] constexpr arrint ChunkCount() const {
+		return keys.Size();
+	}
+
+	[[nodiscard]] constexpr bool Contains(unsigned int value) const {
+		const arrint index = FindChunk((unsigned short)(value >> 16));
+		return index != keys.Size() && containers.Data()[index].Contains((unsigned short)value);
+	}
+
+	/* @return If the value was not already in the set. */
+	constexpr bool Add(unsigned int value) {
+		const unsigned short key = (unsigned short)(value >> 16);
+		const arrint index = flat_search::LowerBound(keys.Data(), keys.Size(), key);
+		if (index == keys.Size() || keys.Data()[index] != key) {
+			keys.Insert(index, key);
+			containers.Insert(index, roaring_container());
+		}
+		return containers.Data()[index].Add((unsigned short)value);
+	}
+
+	/* @return If the value was in the set. */
+	constexpr bool Remove(unsigned int value) {
+		const arrint index = FindChunk((unsigned short)(value >> 16));
+		if (index == keys.Size()) {
+			return false;
+		}
+		roaring_container& container = containers.Data()[index];
+		if (!container.Remove((unsigned short)value)) {
+			return false;
+		}
+		if (container.Cardinality() == 0) {
+			keys.RemoveAt(index);
+			containers.RemoveAt(index);
+		}
+		return true;
+	}
+
+	/* Calls func(unsigned int value) for every value in ascending order. */
+	template<typename Func>
+	constexpr void ForEach(Func&& func) const {
+		for (arrint i = 0; i < keys.Size(); i++) {
+			const unsigned int high = (unsigned int)keys.Data()[i] << 16;
+			containers.Data()[i].ForEach([&func, high](unsigned short low) {
+				func(high | low);
+			});
+		}
+	}
+
+	/* @return Every value in ascending order. */
+	[[nodiscard]] constexpr darray<unsigned int> ToArray() const {
+		darray<unsigned int> out;
+		out.Reserve(arrint(Cardinality()));
+		ForEach([&out](unsigned int value) {
+			out.Add(value);
+		});
+		return out;
+	}
+
+	/* @return The set of values in both this and other. */
+	[[nodiscard]] constexpr roaring_bitmap And(const roaring_bitmap& other) const {
+		return Combine<true>(*this, other);
+	}
+
+	/* @return The set of values in either this or other. */
+	[[nodiscard]] constexpr roaring_bitmap Or(const roaring_bitmap& other) const {
+		return Combine<false>(*this, other);
+	}
+
+	/* @return The number of values in both this and other, without building the intersection. */
+	[[nodiscard]] constexpr unsigned long long AndCardinality(const roaring_bitmap& other) const {
+		unsigned long long count = 0;
+		arrint i = 0;
+		arrint j = 0;
+		while (i < keys.Size() && j < other.keys.Size()) {
+			if (keys.Data()[i] < other.keys.Data()[j]) i++;
+			else if (other.keys.Data()[j] < keys.Data()[i]) j++;
+			else {
+				count += roaring_container::AndCardinality(containers.Data()[i], other.containers.Data()[j]);
+				i++;
+				j++;
+			}
+		}
+		return count;
+	}
+
+};
@@ -0,0 +1,116 @@
+#include "roaring_bitmap.h"
+
+#define TEST_TYPES "Roaring Bitmap"
+#include <testframework/unit_test_compile_time.h>
+
+namespace RoaringBitmapUnitTests
+{
+
+	/* Adds every step'th value in [first, last) to a bitmap. */
+	constexpr void AddRange(roaring_bitmap& bitmap, unsigned int first, unsigned int last, unsigned int step = 1) {
+		for (unsigned int value = first; value < last; value += step) {
+			bitmap.Add(value);
+		}
+	}
+
+#pragma region Add_Remove
+
+	constexpr bool AddContains() {
+		roaring_bitmap bitmap;
+		bitmap.Add(5);
+		bitmap.Add(70000);
+		bitmap.Add(4000000000U);
+		return bitmap.Contains(5) && bitmap.Contains(70000) && bitmap.Contains(4000000000U) && !bitmap.Contains(6)
+			&& bitmap.Cardinality() == 3 && bitmap.ChunkCount() == 3;
+	}
+	TEST_ASSERT(AddContains(), "Roaring bitmap does not contain added values");
+
+	constexpr bool AddDuplicate() {
+		roaring_bitmap bitmap;
+		return bitmap.Add(9) && !bitmap.Add(9) && bitmap.Cardinality() == 1;
+	}
+	TEST_ASSERT(AddDuplicate(), "Roaring bitmap adds a duplicate value");
+
+	constexpr bool RemoveEmptiesChunk() {
+		roaring_bitmap bitmap;
+		bitmap.Add(1);
+		bitmap.Add(100000);
+		return bitmap.Remove(100000) && !bitmap.Remove(100000) && bitmap.ChunkCount() == 1 && bitmap.Cardinality() == 1;
+	}
+	TEST_ASSERT(RemoveEmptiesChunk(), "Roaring bitmap Remove() does not drop an emptied chunk");
+
+	constexpr bool DenseBecomesBitmap() {
+		roaring_bitmap bitmap;
+		AddRange(bitmap, 0, 5000);
+		roaring_bitmap sparse;
+		AddRange(sparse, 0, 5000, 2);
+		return bitmap.Cardinality() == 5000 && bitmap.Contains(4999) && !bitmap.Contains(5000) && sparse.Cardinality() == 2500;
+	}
+	TEST_ASSERT(DenseBecomesBitmap(), "Roaring bitmap is incorrect past the array container limit");
+
+	constexpr bool ContainerConversion() {
+		roaring_container container;
+		for (unsigned int i = 0; i <= roaring_container::ARRAY_MAX; i++) {
+			container.Add((unsigned short)(i * 3));
+		}
+		const bool becameBitmap = container.IsBitmap();
+		container.Remove(0);
+		return becameBitmap && !container.IsBitmap() && container.Cardinality() == roaring_container::ARRAY_MAX && container.Contains(3);
+	}
+	TEST_ASSERT(ContainerConversion(), "Roaring container does not switch between array and bitmap at the limit");
+
+#pragma endregion
+
+#pragma region Set_Operations
+
+	constexpr bool AndSparse() {
+		roaring_bitmap a;
+		roaring_bitmap b;
+		AddRange(a, 0, 150000, 30);
+		AddRange(b, 0, 150000, 50);
+		roaring_bitmap both = a.And(b);
+		return both.Cardinality() == 1000 && both.Contains(150) && !both.Contains(30) && both.ChunkCount() == 3 && a.AndCardinality(b) == 1000;
+	}
+	TEST_ASSERT(AndSparse(), "Roaring bitmap And() of sparse sets is incorrect");
+
+	constexpr bool OrSparse() {
+		roaring_bitmap a;
+		roaring_bitmap b;
+		a.Add(1);
+		a.Add(200000);
+		b.Add(1);
+		b.Add(2);
+		b.Add(900000);
+		roaring_bitmap either = a.Or(b);
+		darray<unsigned int> values = either.ToArray();
+		return values.Size() == 4 && values[0] == 1 && values[1] == 2 && values[2] == 200000 && values[3] == 900000;
+	}
+	TEST_ASSERT(OrSparse(), "Roaring bitmap Or() of sparse sets is incorrect");
+
+	constexpr bool AndOrDense() {
+		roaring_bitmap a;
+		roaring_bitmap b;
+		AddRange(a, 0, 6000);
+		AddRange(b, 3000, 9000);
+		roaring_bitmap both = a.And(b);
+		roaring_bitmap either = a.Or(b);
+		return both.Cardinality() == 3000 && both.Contains(3000) && !both.Contains(2999) && either.Cardinality() == 9000 && a.AndCardinality(b) == 3000;
+	}
+	TEST_ASSERT(AndOrDense(), "Roaring bitmap And() or Or() of dense sets is incorrect");
+
+	constexpr bool AndMixed() {
+		roaring_bitmap dense;
+		roaring_bitmap sparse;
+		AddRange(dense, 0, 5000);
+		sparse.Add(10);
+		sparse.Add(4999);
+		sparse.Add(5000);
+		roaring_bitmap both = dense.And(sparse);
+		roaring_bitmap either = sparse.Or(dense);
+		return both.Cardinality() == 2 && both.Contains(4999) && either.Cardinality() == 5001;
+	}
+	TEST_ASSERT(AndMixed(), "Roaring bitmap operations between array and bitmap containers are incorrect");
+
+#pragma endregion
+
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "flat_search.h"
+
+/* A map kept sorted by key, with the keys and values in two separate darrays. Searching only touches the contiguous keys, so more of them fit per cache line.
+Lookups are a branchless binary search, and there are no per-entry allocations. Bulk insertion sorts and deduplicates the new entries,
+then merges them with the existing entries in one pass. Suited to small and medium maps. Single insertions and erasures move every entry after them.
+@param K: Key type. Must be default constructible and ordered by operator <.
+@param V: Value type. Must be default constructible. */
+template<typename K, typename V>
+struct flat_map
+{
+private:
+
+	darray<K> keys;
+	darray<V> values;
+
+public:
+
+	/* Returned by IndexOf() when the key is not in the map. */
+	static constexpr arrint NOT_FOUND = arrint(-1);
+
+	constexpr flat_map() = default;
+
+	/* Builds a map from entries in any order. When a key appears more than once, the last value is kept.
+	Throws std::invalid_argument if there are not the same number of keys and values. */
+	[[nodiscard]] constexpr static flat_map FromUnsorted(const darray<K>& unsortedKeys, const darray<V>& unsortedValues) {
+		flat_map map;
+		map.InsertBulk(unsortedKeys, unsortedValues);
+		return map;
+	}
+
+	/* @return The number of entries in the map. */
+	constexpr arrint Size() const {
+		return keys.Size();
+	}
+
+	constexpr bool IsEmpty() const {
+		return keys.Size() == 0;
+	}
+
+	/* @return The index of a key in sorted order, or NOT_FOUND. */
+	[[nodiscard]] constexpr arrint IndexOf(const K& key) const {
+		const arrint index = flat_search::LowerBound(keys.Data(), keys.Size(), key);
+		if (index == keys.Size() || key < keys.Data()[index]) {
+			return NOT_FOUND;
+		}
+		return index;
+	}
+
+	[[nodiscard]] constexpr bool Contains(const K& key) const {
+		return IndexOf(key) != NOT_FOUND;
+	}
+
+	/* @return Pointer to the value of a key, or nullptr if the key is not in the map. Invalidated by any insertion or erasure. */
+	[[nodiscard]] constexpr V* Find(const K& key) {
+		const arrint index = IndexOf(key);
+		return index == NOT_FOUND ? nullptr : values.Data() + index;
+	}
+
+	/* @return Pointer to the value of a key, or nullptr if the key is not in the map. Invalidated by any insertion or erasure. */
+	[[nodiscard]] constexpr const V* Find(const K& key) const {
+		const arrint index = IndexOf(key);
+		return index == NOT_FOUND ? nullptr : values.Data() + index;
+	}
+
+	/* Get the value of a key. Throws std::out_of_range if the key is not in the map. */
+	[[nodiscard]] constexpr V& At(const K& key) {
+		V* value = Find(key);
+		if (value == nullptr) {
+			throw std::out_of_range("Flat map At() key is not in the map!");
+		}
+		return *value;
+	}
+
+	/* Get the value of a key. Throws std::out_of_range if the key is not in the map. */
+	[[nodiscard]] constexpr const V& At(const K& key) const {
+		const V* value = Find(key);
+		if (value == nullptr) {
+			throw std::out_of_range("Flat map At() key is not in the map!");
+		}
+		return *value;
+	}
+
+	/* Get the key at an index in sorted order. */
+	[[nodiscard]] constexpr const K& KeyAt(arrint index) const {
+		bounds_check::Index(index, keys.Size(), "Flat map KeyAt() index is out of bounds!");
+		return keys.Data()[index];
+	}
+
+	/* Get the value at an index in key order. */
+	[[nodiscard]] constexpr V& ValueAt(arrint index) {
+		bounds_check::Index(index, values.Size(), "Flat map ValueAt() index is out of bounds!");
+		return values.Data()[index];
+	}
+
+	/* Get the value at an index in key order. */
+	[[nodiscard]] constexpr const V& ValueAt(arrint index) const {
+		bounds_check::Index(index, values.Size(), "Flat map ValueAt() index is out of bounds!");
+		return values.Data()[index];
+	}
+
+	/* Get every key in sorted order. */
+	[[nodiscard]] constexpr const darray<K>& Keys() const {
+		return keys;
+	}
+
+	/* Get every value in key order. */
+	[[nodiscard]] constexpr const darray<V>& Values() const {
+		return values;
+	}
+
+	/* Inserts an entry, or assigns the value if the key is already in the map.
+	@return If a new entry was inserted. */
+	constexpr bool Insert(const K& key, const V& value) {
+		const arrint index = flat_search::LowerBound(keys.Data(), keys.Size(), key);
+		if (index != keys.Size() && !(key < keys.Data()[index])) {
+			values.Data()[index] = value;
+			return false;
+		}
+		keys.Insert(index, key);
+		values.Insert(index, value);
+		return true;
+	}
+
+	/* Inserts an entry, or assigns the value if the key is already in the map.
+	@return If a new entry was inserted. */
+	constexpr bool Insert(const K& key, V&& value) {
+		const arrint index = flat_search::LowerBound(keys.Data(), keys.Size(), key);
+		if (index != keys.Size() && !(key < keys.Data()[index])) {
+			values.Data()[index] = std::move(value);
+			return false;
+		}
+		keys.Insert(index, key);
+		values.Insert(index, std::move(value));
+		return true;
+	}
+
+	/* Removes an entry.
+	@return If the key was in the map. */
+	constexpr bool Erase(const K& key) {
+		const arrint index = IndexOf(key);
+		if (index == NOT_FOUND) {
+			return false;
+		}
+		keys.RemoveAt(index);
+		values.RemoveAt(index);
+		return true;
+	}
+
+	/* Inserts many entries in any order. Sorts and deduplicates them, keeping the last value of each key, then merges them with the existing entries
+	in a single pass. New values replace the values of existing keys. */
+	constexpr void InsertBulk(const K* newKeys, const V* newValues, arrint count) {
+		const darray<arrint> unique = flat_search::SortedUniqueIndices(newKeys, count);
+		const K* existingKeys = keys.Data();
+		V* existingValues = values.Data();
+		const arrint existingCount = keys.Size();
+		const arrint uniqueCount = unique.Size();
+
+		darray<K> mergedKeys;
+		darray<V> mergedValues;
+		mergedKeys.Reserve(existingCount + uniqueCount);
+		mergedValues.Reserve(existingCount + uniqueCount);
+		arrint i = 0;
+		arrint j = 0;
+		while (i < existingCount && j < uniqueCount) {
+			const arrint newIndex = unique.Data()[j];
+			if (existingKeys[i] < newKeys[newIndex]) {
+				mergedKeys.Add(existingKeys[i]);
+				mergedValues.Add(std::move(existingValues[i]));
+				i++;
+			}
+			else if (newKeys[newIndex] < existingKeys[i]) {
+				mergedKeys.Add(newKeys[newIndex]);
+				mergedValues.Add(newValues[newIndex]);
+				j++;
+			}
+			else {
+				mergedKeys.Add(existingKeys[i]);
+				mergedValues.Add(newValues[newIndex]);
+				i++;
+				j++;
+			}
+		}
+		for (; i < existingCount; i++) {
+			mergedKeys.Add(existingKeys[i]);
+			mergedValues.Add(std::move(existingValues[i]));
+		}
+		for (; j < uniqueCount; j++) {
+			const arrint newIndex = unique.Data()[j];
+			mergedKeys.Add(newKeys[newIndex]);
+			mergedValues.Add(newValues[newIndex]);
+		}
+		keys = std::move(mergedKeys);
+		values = std::move(mergedValues);
+	}
+
+	/* Inserts many entries in any order. Throws std::invalid_argument if there are not the same number of keys and values. */
+	constexpr void InsertBulk(const darray<K>& newKeys, const darray<V>& newValues) {
+		if (newKeys.Size() != newValues.Size()) {
+			throw std::invalid_argument("Flat map InsertBulk() requires the same number of keys and values!");
+		}
+		InsertBulk(newKeys.Data(), newValues.Data(), newKeys.Size());
+	}
+
+	/* Removes every entry, keeping the allocations. */
+	constexpr void Clear() {
+		keys.Clear();
+		values.Clear();
+	}
+
+};
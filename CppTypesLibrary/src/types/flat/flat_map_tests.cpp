@@ -0,0 +1,81 @@
+#include "flat_map.h"
+
+#define TEST_TYPES "Flat Map"
+#include <testframework/unit_test_compile_time.h>
+
+#include "../string/string.h"
+
+namespace FlatMapUnitTests
+{
+
+#pragma region Insert_Find
+
+	constexpr bool InsertAndFind() {
+		flat_map<int, int> map;
+		for (int i = 20; i > 0; i--) {
+			if (!map.Insert(i, i * 10)) return false;
+		}
+		for (int i = 1; i <= 20; i++) {
+			const int* value = map.Find(i);
+			if (value == nullptr || *value != i * 10) return false;
+		}
+		return map.Size() == 20 && map.Find(0) == nullptr && map.KeyAt(0) == 1 && map.ValueAt(19) == 200;
+	}
+	TEST_ASSERT(InsertAndFind(), "Flat map does not find inserted values");
+
+	constexpr bool InsertAssignsExisting() {
+		flat_map<int, int> map;
+		map.Insert(1, 10);
+		return !map.Insert(1, 20) && map.Size() == 1 && map.At(1) == 20;
+	}
+	TEST_ASSERT(InsertAssignsExisting(), "Flat map Insert() of an existing key does not assign its value");
+
+	constexpr bool Erase() {
+		flat_map<int, string> map;
+		map.Insert(1, string("one"));
+		map.Insert(2, string("a string long enough to need a heap allocation"));
+		map.Insert(3, string("three"));
+		return map.Erase(2) && !map.Erase(2) && map.Size() == 2 && map.At(3) == "three" && map.ValueAt(0) == "one";
+	}
+	TEST_ASSERT(Erase(), "Flat map Erase() does not remove the key and its value");
+
+#pragma endregion
+
+#pragma region Bulk
+
+	constexpr bool FromUnsortedKeepsLast() {
+		darray<string> keys;
+		darray<int> values;
+		keys.Add(string("cherry"));
+		values.Add(3);
+		keys.Add(string("apple"));
+		values.Add(1);
+		keys.Add(string("cherry"));
+		values.Add(30);
+		keys.Add(string("banana"));
+		values.Add(2);
+		flat_map<string, int> map = flat_map<string, int>::FromUnsorted(keys, values);
+		return map.Size() == 3 && map.KeyAt(0) == "apple" && map.KeyAt(2) == "cherry" && map.At(string("cherry")) == 30 && map.At(string("banana")) == 2;
+	}
+	TEST_ASSERT(FromUnsortedKeepsLast(), "Flat map FromUnsorted() does not sort, or keep the last value of duplicate keys");
+
+	constexpr bool InsertBulkMerges() {
+		flat_map<int, int> map;
+		map.Insert(2, 20);
+		map.Insert(4, 40);
+		darray<int> keys;
+		darray<int> values;
+		keys.Add(4);
+		values.Add(400);
+		keys.Add(1);
+		values.Add(100);
+		keys.Add(5);
+		values.Add(500);
+		map.InsertBulk(keys, values);
+		return map.Size() == 4 && map.At(1) == 100 && map.At(2) == 20 && map.At(4) == 400 && map.At(5) == 500 && map.KeyAt(3) == 5;
+	}
+	TEST_ASSERT(InsertBulkMerges(), "Flat map InsertBulk() does not merge with, and replace, existing entries");
+
+#pragma endregion
+
+}
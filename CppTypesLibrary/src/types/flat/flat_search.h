@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../array/dynamic_array.h"
+#include <algorithm>
+
+/* Search and bulk build helpers shared by flat_set and flat_map, which keep their keys sorted and unique in a darray. */
+struct flat_search
+{
+	/* Branchless binary search. Halves the range each step with a conditional move instead of a branch, so the loop has a fixed trip count
+	for a given size and never mispredicts.
+	@return Index of the first key that is not less than key, or size if every key is less. */
+	template<typename K>
+	[[nodiscard]] constexpr static arrint LowerBound(const K* keys, arrint size, const K& key) {
+		if (size == 0) return 0;
+		const K* base = keys;
+		arrint len = size;
+		while (len > 1) {
+			const arrint half = len / 2;
+			base = (base[half] < key) ? base + half : base;
+			len -= half;
+		}
+		return arrint(base - keys) + arrint(*base < key);
+	}
+
+	/* Sorts the indices of keys by key, keeping only the last index of each run of equal keys, so later duplicates replace earlier ones.
+	@return Indices of the unique keys in sorted order. */
+	template<typename K>
+	[[nodiscard]] constexpr static darray<arrint> SortedUniqueIndices(const K* keys, arrint count) {
+		darray<arrint> indices;
+		indices.Reserve(count);
+		for (arrint i = 0; i < count; i++) {
+			indices.Add(i);
+		}
+		std::sort(indices.Data(), indices.Data() + count, [keys](arrint a, arrint b) {
+			if (keys[a] < keys[b]) return true;
+			if (keys[b] < keys[a]) return false;
+			return a < b;
+		});
+
+		darray<arrint> unique;
+		unique.Reserve(count);
+		for (arrint i = 0; i < count; i++) {
+			const bool lastOfRun = i + 1 == count || keys[indices[i]] < keys[indices[i + 1]];
+			if (lastOfRun) {
+				unique.Add(indices[i]);
+			}
+		}
+		return unique;
+	}
+
+};
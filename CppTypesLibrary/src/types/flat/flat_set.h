@@ -0,0 +1,134 @@
+#pragma once
+
+#include "flat_search.h"
+
+/* A set of unique keys kept sorted in a single darray. Lookups are a branchless binary search over contiguous keys, and there are no per-key allocations.
+Bulk insertion sorts and deduplicates the new keys, then merges them with the existing keys in one pass.
+Suited to small and medium sets. Single insertions and erasures move every key after them.
+@param K: Key type. Must be default constructible and ordered by operator <. */
+template<typename K>
+struct flat_set
+{
+private:
+
+	darray<K> keys;
+
+public:
+
+	/* Returned by IndexOf() when the key is not in the set. */
+	static constexpr arrint NOT_FOUND = arrint(-1);
+
+	constexpr flat_set() = default;
+
+	/* Builds a set from keys in any order, with duplicates removed. */
+	[[nodiscard]] constexpr static flat_set FromUnsorted(const darray<K>& unsortedKeys) {
+		flat_set set;
+		set.InsertBulk(unsortedKeys);
+		return set;
+	}
+
+	/* @return The number of keys in the set. */
+	constexpr arrint Size() const {
+		return keys.Size();
+	}
+
+	constexpr bool IsEmpty() const {
+		return keys.Size() == 0;
+	}
+
+	/* @return The index of a key in sorted order, or NOT_FOUND. */
+	[[nodiscard]] constexpr arrint IndexOf(const K& key) const {
+		const arrint index = flat_search::LowerBound(keys.Data(), keys.Size(), key);
+		if (index == keys.Size() || key < keys.Data()[index]) {
+			return NOT_FOUND;
+		}
+		return index;
+	}
+
+	[[nodiscard]] constexpr bool Contains(const K& key) const {
+		return IndexOf(key) != NOT_FOUND;
+	}
+
+	/* Get the key at an index in sorted order. */
+	[[nodiscard]] constexpr const K& KeyAt(arrint index) const {
+		bounds_check::Index(index, keys.Size(), "Flat set KeyAt() index is out of bounds!");
+		return keys.Data()[index];
+	}
+
+	/* Get every key in sorted order. */
+	[[nodiscard]] constexpr const darray<K>& Keys() const {
+		return keys;
+	}
+
+	/* Inserts a key if it is not already in the set.
+	@return If the key was inserted. */
+	constexpr bool Insert(const K& key) {
+		const arrint index = flat_search::LowerBound(keys.Data(), keys.Size(), key);
+		if (index != keys.Size() && !(key < keys.Data()[index])) {
+			return false;
+		}
+		keys.Insert(index, key);
+		return true;
+	}
+
+	/* Removes a key.
+	@return If the key was in the set. */
+	constexpr bool Erase(const K& key) {
+		const arrint index = IndexOf(key);
+		if (index == NOT_FOUND) {
+			return false;
+		}
+		keys.RemoveAt(index);
+		return true;
+	}
+
+	/* Inserts many keys in any order. Sorts and deduplicates them, then merges them with the existing keys in a single pass. */
+	constexpr void InsertBulk(const K* newKeys, arrint count) {
+		const darray<arrint> unique = flat_search::SortedUniqueIndices(newKeys, count);
+		const K* existing = keys.Data();
+		const arrint existingCount = keys.Size();
+		const arrint uniqueCount = unique.Size();
+
+		darray<K> merged;
+		merged.Reserve(existingCount + uniqueCount);
+		arrint i = 0;
+		arrint j = 0;
+		while (i < existingCount && j < uniqueCount) {
+			const K& newKey = newKeys[unique.Data()[j]];
+			if (existing[i] < newKey) {
+				merged.Add(existing[i]);
+				i++;
+			}
+			else if (newKey < existing[i]) {
+				merged.Add(newKey);
+				j++;
+			}
+			else {
+				merged.Add(existing[i]);
+				i++;
+				j++;
+			}
+		}
+		for (; i < existingCount; i++) {
+			merged.Add(existing[i]);
+		}
+		for (; j < uniqueCount; j++) {
+			merged.Add(newKeys[unique.Data()[j]]);
+		}
+		keys = std::move(merged);
+	}
+
+	constexpr void InsertBulk(const darray<K>& newKeys) {
+		InsertBulk(newKeys.Data(), newKeys.Size());
+	}
+
+	/* Removes every key, keeping the allocation. */
+	constexpr void Clear() {
+		keys.Clear();
+	}
+
+	[[nodiscard]] constexpr const K* begin() const { return keys.Data(); }
+
+	[[nodiscard]] constexpr const K* end() const { return keys.Data() + keys.Size(); }
+
+};
@@ -0,0 +1,105 @@
+#include "flat_set.h"
+
+#define TEST_TYPES "Flat Set"
+#include <testframework/unit_test_compile_time.h>
+
+#include "../string/string.h"
+
+namespace FlatSetUnitTests
+{
+
+#pragma region Insert_Find
+
+	constexpr bool InsertSorted() {
+		flat_set<int> set;
+		const int keys[] = { 5, 1, 9, 3, 7 };
+		for (int key : keys) {
+			if (!set.Insert(key)) return false;
+		}
+		return set.Size() == 5 && set.KeyAt(0) == 1 && set.KeyAt(2) == 5 && set.KeyAt(4) == 9;
+	}
+	TEST_ASSERT(InsertSorted(), "Flat set does not keep its keys sorted");
+
+	constexpr bool InsertDuplicate() {
+		flat_set<int> set;
+		set.Insert(4);
+		return !set.Insert(4) && set.Size() == 1;
+	}
+	TEST_ASSERT(InsertDuplicate(), "Flat set inserts a duplicate key");
+
+	constexpr bool ContainsAndIndexOf() {
+		flat_set<int> set;
+		for (int i = 0; i < 100; i += 2) {
+			set.Insert(i);
+		}
+		for (int i = 0; i < 100; i++) {
+			if (set.Contains(i) != (i % 2 == 0)) return false;
+		}
+		return set.IndexOf(10) == 5 && set.IndexOf(-1) == set.NOT_FOUND && set.IndexOf(1000) == set.NOT_FOUND;
+	}
+	TEST_ASSERT(ContainsAndIndexOf(), "Flat set search is incorrect");
+
+	constexpr bool EmptySearch() {
+		flat_set<int> set;
+		return !set.Contains(0) && set.IsEmpty();
+	}
+	TEST_ASSERT(EmptySearch(), "Flat set search of an empty set is incorrect");
+
+	constexpr bool Erase() {
+		flat_set<int> set;
+		set.Insert(1);
+		set.Insert(2);
+		set.Insert(3);
+		return set.Erase(2) && !set.Erase(2) && set.Size() == 2 && !set.Contains(2) && set.Contains(3);
+	}
+	TEST_ASSERT(Erase(), "Flat set Erase() is incorrect");
+
+#pragma endregion
+
+#pragma region Bulk
+
+	constexpr bool FromUnsortedDedups() {
+		darray<int> keys;
+		const int unsorted[] = { 8, 3, 8, 1, 3, 9, 1, 0 };
+		for (int key : unsorted) {
+			keys.Add(key);
+		}
+		flat_set<int> set = flat_set<int>::FromUnsorted(keys);
+		const int expected[] = { 0, 1, 3, 8, 9 };
+		if (set.Size() != 5) return false;
+		arrint i = 0;
+		for (int key : set) {
+			if (key != expected[i]) return false;
+			i++;
+		}
+		return true;
+	}
+	TEST_ASSERT(FromUnsortedDedups(), "Flat set FromUnsorted() does not sort and deduplicate");
+
+	constexpr bool InsertBulkMerges() {
+		flat_set<int> set;
+		set.Insert(2);
+		set.Insert(6);
+		set.Insert(10);
+		darray<int> more;
+		more.Add(7);
+		more.Add(2);
+		more.Add(1);
+		more.Add(11);
+		set.InsertBulk(more);
+		return set.Size() == 6 && set.KeyAt(0) == 1 && set.KeyAt(1) == 2 && set.KeyAt(3) == 7 && set.KeyAt(5) == 11;
+	}
+	TEST_ASSERT(InsertBulkMerges(), "Flat set InsertBulk() does not merge with the existing keys");
+
+	constexpr bool StringKeys() {
+		flat_set<string> set;
+		set.Insert(string("pear"));
+		set.Insert(string("a string long enough to need a heap allocation"));
+		set.Insert(string("apple"));
+		return set.KeyAt(0) == "a string long enough to need a heap allocation" && set.KeyAt(1) == "apple" && set.Contains(string("pear"));
+	}
+	TEST_ASSERT(StringKeys(), "Flat set of strings is incorrect");
+
+#pragma endregion
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../array/dynamic_array.h"
+#include "../string/string.h"
+#include <array>
+
+/* A string whose characters are embedded in the program's read only data. Produced by FreezeString(). */
+template<size_t LEN>
+struct frozen_string
+{
+	/* Characters followed by a null terminator. */
+	char chars[LEN + 1];
+
+	/* Get the length of this string. */
+	[[nodiscard]] constexpr static size_t Len() { return LEN; }
+
+	/* Get this string's characters as a null terminated const char*. */
+	[[nodiscard]] constexpr const char* CStr() const { return chars; }
+
+	[[nodiscard]] constexpr std::string_view View() const { return std::string_view(chars, LEN); }
+
+	/* Get the hash of this string's characters. Equal to the hash of a buffer_string of the same characters. */
+	[[nodiscard]] constexpr unsigned long long Hash() const {
+		return string_simd::Hash(chars, LEN);
+	}
+
+	[[nodiscard]] constexpr bool operator == (std::string_view str) const {
+		return str.size() == LEN && string_simd::FindMismatch(chars, str.data(), LEN) == LEN;
+	}
+
+};
+
+/* Gets the element type of a darray. */
+template<typename Array>
+struct frozen_element;
+
+template<typename T>
+struct frozen_element<darray<T>>
+{
+	using type = T;
+};
+
+/* Runs a darray building function at compile time, and copies the result into a std::array of the exact size.
+The darray's heap allocation cannot outlive constant evaluation, but the returned array can be stored in a static constexpr variable,
+so the table is embedded in the program's read only data and nothing is built at startup. The builder runs twice, once to find the size.
+@param Builder: Captureless lambda or default constructible function object returning a darray.
+
+static constexpr auto squares = Freeze([]() {
+	darray<int> arr;
+	for (int i = 0; i < 16; i++) arr.Add(i * i);
+	return arr;
+}); */
+template<typename Builder>
+consteval auto Freeze(Builder) {
+	using T = typename frozen_element<decltype(Builder{}())>::type;
+	constexpr arrint SIZE = Builder{}().Size();
+
+	std::array<T, SIZE> frozen{};
+	auto arr = Builder{}();
+	for (arrint i = 0; i < SIZE; i++) {
+		frozen[i] = arr[i];
+	}
+	return frozen;
+}
+
+/* Runs a buffer_string building function at compile time, and copies the characters into a frozen_string of the exact length.
+The builder runs twice, once to find the length.
+@param Builder: Captureless lambda or default constructible function object returning a buffer_string. */
+template<typename Builder>
+consteval auto FreezeString(Builder) {
+	constexpr size_t LEN = Builder{}().Len();
+
+	frozen_string<LEN> frozen{};
+	auto str = Builder{}();
+	const char* chars = str.CStr();
+	for (size_t i = 0; i < LEN; i++) {
+		frozen.chars[i] = chars[i];
+	}
+	frozen.chars[LEN] = '\0';
+	return frozen;
+}
@@ -0,0 +1,74 @@
+#include "freeze.h"
+
+#define TEST_TYPES "Freeze"
+#include <testframework/unit_test_compile_time.h>
+
+namespace FreezeUnitTests
+{
+
+#pragma region Freeze_Array
+
+	static constexpr auto squares = Freeze([]() {
+		darray<int> arr;
+		for (int i = 0; i < 16; i++) {
+			arr.Add(i * i);
+		}
+		return arr;
+	});
+
+	static_assert(std::is_same_v<decltype(squares), const std::array<int, 16>>, "Frozen array is not sized to the built array");
+	TEST_ASSERT(squares[0] == 0 && squares[5] == 25 && squares[15] == 225, "Frozen array does not hold the built elements");
+
+	static constexpr auto primes = Freeze([]() {
+		darray<bool> composite;
+		for (int i = 0; i < 100; i++) {
+			composite.Add(false);
+		}
+		darray<unsigned int> found;
+		for (unsigned int i = 2; i < 100; i++) {
+			if (composite[i]) continue;
+			found.Add(i);
+			for (unsigned int j = i * i; j < 100; j += i) {
+				composite[j] = true;
+			}
+		}
+		return found;
+	});
+
+	TEST_ASSERT(primes.size() == 25 && primes[0] == 2 && primes[24] == 97, "Frozen prime sieve table is incorrect");
+
+	static constexpr auto empty = Freeze([]() {
+		return darray<double>();
+	});
+
+	TEST_ASSERT(empty.size() == 0, "Frozen empty array is not empty");
+
+#pragma endregion
+
+#pragma region Freeze_String
+
+	static constexpr auto shortString = FreezeString([]() {
+		string s = "frozen";
+		s.ToUpper();
+		return s;
+	});
+
+	TEST_ASSERT(shortString.Len() == 6 && shortString == "FROZEN" && shortString.CStr()[6] == '\0', "Frozen sso string does not hold the built characters");
+
+	static constexpr auto longString = FreezeString([]() {
+		string s = "A STRING THAT DOES NOT FIT IN THE SSO BUFFER";
+		s.ToLower();
+		return s;
+	});
+
+	TEST_ASSERT(longString == "a string that does not fit in the sso buffer", "Frozen heap string does not hold the built characters");
+
+	static constexpr auto number = FreezeString([]() {
+		return string::From(-42);
+	});
+
+	TEST_ASSERT(number == "-42" && number.Hash() == string("-42").Hash(), "Frozen number string is incorrect");
+
+#pragma endregion
+
+}
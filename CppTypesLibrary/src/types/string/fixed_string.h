@@ -0,0 +1,191 @@
+#pragma once
+
+#include "string_simd.h"
+#include "../../diagnostics/bounds_checking.h"
+#include <compare>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+
+/* A string that always stores its characters inline, and never allocates. Holds up to N - 1 characters.
+The length is kept in the trailing byte as the remaining capacity, so a full string's trailing byte is 0 and doubles as its null terminator.
+Trivially copyable, so arrays of fixed strings are copied with memcpy, and usable as a non-type template parameter.
+Throws std::length_error if characters would exceed the capacity.
+@param N: Total size in bytes, including the trailing byte. Must be between 1 and 256. */
+template<size_t N>
+struct fixed_string
+{
+	static_assert(N >= 1 && N <= 256, "fixed_string size must be between 1 and 256 bytes");
+
+	/* Maximum number of characters. */
+	static constexpr size_t CAPACITY = N - 1;
+
+	/* Characters, followed by zeros up to the trailing byte, which holds CAPACITY - Len().
+	Public only so fixed_string is a structural type. Modify through the member functions. */
+	char chars[N];
+
+private:
+
+	constexpr void SetLength(size_t len) {
+		chars[N - 1] = char((unsigned char)(CAPACITY - len));
+	}
+
+public:
+
+	constexpr fixed_string()
+		: chars{}
+	{
+		SetLength(0);
+	}
+
+	/* Construct from a character array, such as a string literal. Stops at the first null character. */
+	template<size_t M>
+	constexpr fixed_string(const char(&str)[M])
+		: chars{}
+	{
+		static_assert(M <= N, "String literal does not fit in the fixed_string");
+		const std::string_view view = ArrayView(str);
+		Assign(view.data(), view.size());
+	}
+
+	constexpr fixed_string(const char* str, size_t len)
+		: chars{}
+	{
+		Assign(str, len);
+	}
+
+	constexpr explicit fixed_string(std::string_view str)
+		: chars{}
+	{
+		Assign(str.data(), str.size());
+	}
+
+	/* Get the length of this string. */
+	[[nodiscard]] constexpr size_t Len() const { return CAPACITY - (unsigned char)chars[N - 1]; }
+
+	/* Get the maximum number of characters this string can hold. */
+	[[nodiscard]] constexpr static size_t Capacity() { return CAPACITY; }
+
+	[[nodiscard]] constexpr bool IsEmpty() const { return Len() == 0; }
+
+	/* Get this string's characters as a null terminated const char*. */
+	[[nodiscard]] constexpr const char* CStr() const { return chars; }
+
+	/* DANGEROUS. Get this string's characters for modification. Only the first Len() characters may be written. */
+	[[nodiscard]] constexpr char* Data() { return chars; }
+
+	[[nodiscard]] constexpr std::string_view View() const { return std::string_view(chars, Len()); }
+
+	/* Bounds checked according to CONTAINER_CHECK_POLICY. */
+	[[nodiscard]] constexpr char At(size_t index) const {
+		bounds_check::Index(index, Len(), "Fixed string At() index is out of bounds!");
+		return chars[index];
+	}
+
+	[[nodiscard]] constexpr char operator [] (size_t index) const {
+		return At(index);
+	}
+
+	/* Replace this string's characters. */
+	constexpr void Assign(const char* str, size_t len) {
+		if (len > CAPACITY) {
+			throw std::length_error("Fixed string Assign() exceeds capacity!");
+		}
+		const size_t oldLen = Len();
+		for (size_t i = 0; i < len; i++) {
+			chars[i] = str[i];
+		}
+		for (size_t i = len; i < oldLen; i++) {
+			chars[i] = '\0';
+		}
+		SetLength(len);
+	}
+
+	/* Append characters to the end of this string. */
+	constexpr void Append(const char* str, size_t len) {
+		const size_t oldLen = Len();
+		if (len > CAPACITY - oldLen) {
+			throw std::length_error("Fixed string Append() exceeds capacity!");
+		}
+		for (size_t i = 0; i < len; i++) {
+			chars[oldLen + i] = str[i];
+		}
+		SetLength(oldLen + len);
+	}
+
+	constexpr void Append(std::string_view str) {
+		Append(str.data(), str.size());
+	}
+
+	constexpr void Append(char c) {
+		Append(&c, 1);
+	}
+
+	constexpr void Clear() {
+		Assign(nullptr, 0);
+	}
+
+	/* Get the hash of this string's characters. Equal to the hash of a buffer_string, and the _hs literal, of the same characters. */
+	[[nodiscard]] constexpr unsigned long long Hash() const {
+		return string_simd::Hash(chars, Len());
+	}
+
+	/* Strings of the same size are zero padded identically, so equality compares the whole array including the length byte. */
+	[[nodiscard]] constexpr bool operator == (const fixed_string<N>& other) const {
+		return string_simd::FindMismatch(chars, other.chars, N) == N;
+	}
+
+	template<size_t M>
+	[[nodiscard]] constexpr bool operator == (const fixed_string<M>& other) const {
+		return View() == other.View();
+	}
+
+	[[nodiscard]] constexpr bool operator == (std::string_view str) const {
+		const size_t len = Len();
+		return len == str.size() && string_simd::FindMismatch(chars, str.data(), len) == len;
+	}
+
+	/* Compares against a character array, such as a string literal, up to its first null character. */
+	template<size_t M>
+	[[nodiscard]] constexpr bool operator == (const char(&str)[M]) const {
+		return *this == ArrayView(str);
+	}
+
+	/* Lexicographically compares as unsigned bytes, the same order as buffer_string. */
+	template<size_t M>
+	[[nodiscard]] constexpr std::strong_ordering operator <=> (const fixed_string<M>& other) const {
+		return string_simd::Compare(chars, Len(), other.chars, other.Len()) <=> 0;
+	}
+
+	[[nodiscard]] constexpr std::strong_ordering operator <=> (std::string_view str) const {
+		return string_simd::Compare(chars, Len(), str.data(), str.size()) <=> 0;
+	}
+
+	template<size_t M>
+	[[nodiscard]] constexpr std::strong_ordering operator <=> (const char(&str)[M]) const {
+		return *this <=> ArrayView(str);
+	}
+
+private:
+
+	template<size_t M>
+	[[nodiscard]] constexpr static std::string_view ArrayView(const char(&str)[M]) {
+		size_t len = 0;
+		while (len < M && str[len] != '\0') {
+			len++;
+		}
+		return std::string_view(str, len);
+	}
+
+};
+
+template<size_t M>
+fixed_string(const char(&)[M]) -> fixed_string<M>;
+
+template<size_t N>
+struct std::hash<fixed_string<N>>
+{
+	size_t operator()(const fixed_string<N>& str) const {
+		return (size_t)str.Hash();
+	}
+};
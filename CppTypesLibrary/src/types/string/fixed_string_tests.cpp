@@ -0,0 +1,107 @@
+#include "fixed_string.h"
+#include "string_hash.h"
+#include "../array/dynamic_array.h"
+
+#define TEST_TYPES "Fixed String"
+#include <testframework/unit_test_compile_time.h>
+
+namespace FixedStringUnitTests
+{
+
+	static_assert(std::is_trivially_copyable_v<fixed_string<32>>, "fixed_string must be trivially copyable");
+	static_assert(sizeof(fixed_string<32>) == 32, "fixed_string must not store anything besides its characters");
+
+#pragma region Construction
+
+	constexpr bool DefaultEmpty() {
+		fixed_string<16> s;
+		return s.Len() == 0 && s.IsEmpty() && s.CStr()[0] == '\0' && s.Capacity() == 15;
+	}
+	TEST_ASSERT(DefaultEmpty(), "Default fixed string is not empty");
+
+	constexpr bool FromLiteral() {
+		fixed_string<16> s = "hello";
+		return s.Len() == 5 && s == "hello" && s.CStr()[5] == '\0';
+	}
+	TEST_ASSERT(FromLiteral(), "Fixed string from a literal has the wrong characters");
+
+	constexpr bool FullCapacity() {
+		fixed_string<8> s = "1234567";
+		return s.Len() == 7 && s.CStr()[7] == '\0' && s == "1234567";
+	}
+	TEST_ASSERT(FullCapacity(), "Full fixed string does not use the trailing byte as its null terminator");
+
+#pragma endregion
+
+#pragma region Modify
+
+	constexpr bool AppendAndAssign() {
+		fixed_string<16> s = "net";
+		s.Append('_');
+		s.Append("field");
+		if (s != "net_field") return false;
+		s.Assign("id", 2);
+		return s == "id" && s.Len() == 2 && s == fixed_string<16>("id");
+	}
+	TEST_ASSERT(AppendAndAssign(), "Fixed string Append() or Assign() is incorrect");
+
+	constexpr bool ClearEmpties() {
+		fixed_string<16> s = "hello";
+		s.Clear();
+		return s.IsEmpty() && s == fixed_string<16>();
+	}
+	TEST_ASSERT(ClearEmpties(), "Fixed string Clear() does not empty the string");
+
+#pragma endregion
+
+#pragma region Compare_Hash
+
+	constexpr bool CompareOrdering() {
+		fixed_string<16> a = "apple";
+		fixed_string<32> b = "banana";
+		return a < b && b > a && a == fixed_string<32>("apple") && (a <=> std::string_view("apple")) == std::strong_ordering::equal;
+	}
+	TEST_ASSERT(CompareOrdering(), "Fixed string ordering is incorrect");
+
+	constexpr bool HashMatchesString() {
+		fixed_string<32> f = "hello world!";
+		string s = "hello world!";
+		return f.Hash() == s.Hash() && f.Hash() == "hello world!"_hs;
+	}
+	TEST_ASSERT(HashMatchesString(), "Fixed string hash does not match buffer_string hash of the same characters");
+
+#pragma endregion
+
+#pragma region Template_Parameter
+
+	template<fixed_string NAME>
+	constexpr size_t NameLength() {
+		return NAME.Len();
+	}
+
+	template<fixed_string NAME>
+	constexpr unsigned long long NameHash() {
+		return NAME.Hash();
+	}
+
+	TEST_ASSERT(NameLength<"position">() == 8, "Fixed string template parameter has the wrong length");
+	TEST_ASSERT(NameHash<"velocity">() == "velocity"_hs, "Fixed string template parameter has the wrong hash");
+
+#pragma endregion
+
+#pragma region Array
+
+	constexpr bool ArrayReallocates() {
+		darray<fixed_string<16>> arr;
+		for (int i = 0; i < 20; i++) {
+			fixed_string<16> s = "field";
+			s.Append(char('a' + i));
+			arr.Add(s);
+		}
+		return arr.Size() == 20 && arr[0] == "fielda" && arr[19] == "fieldt";
+	}
+	TEST_ASSERT(ArrayReallocates(), "Array of fixed strings loses characters when reallocating");
+
+#pragma endregion
+
+}
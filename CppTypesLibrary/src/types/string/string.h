@@ -4,11 +4,28 @@
 #include <psapi.h>
 #include <libloaderapi.h>
 #include <iostream>
+#include <charconv>
+#include <compare>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include "../../diagnostics/alloc_tracking.h"
+#include "../../diagnostics/bounds_checking.h"
+#include "../array/dynamic_array.h"
+#include "utf8.h"
+#include "string_simd.h"
+#include "string_split.h"
+#include "string_pool.h"
 
 #define _STRING_SSO_ALIGNMENT 32
 
 constexpr const char* _emptyString = "";
 
+/* Every two digit pair from 00 to 99, used to format integers two digits at a time. */
+constexpr const char* _digitPairs = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+struct string_builder;
+
 /* A constexpr, sso, and const segment enabled string class. Can check if const char*'s passed in exist within the application const data segment,
 and avoid doing unnecessary copying with this.
 @param BUFFER_SIZE: Size of the sso character buffer. Must be a multiple of 32. */
@@ -23,6 +40,9 @@ struct
 {
 	static_assert(BUFFER_SIZE % _STRING_SSO_ALIGNMENT == 0, "The size of the buffer characters must be a multiple of _STRING_SSO_ALIGNMENT (32)");
 
+	friend struct string_builder;
+	friend struct binary_reader;
+
 private:
 
 	/* Small String Optimization buffer. */
@@ -38,10 +58,10 @@ private:
 	size_t capacity;
 
 	/* Is this string currently using the sso buffer? */
-	unsigned char flagSSOBuffer : 1;
+	unsigned char flagSSOBuffer : 1 = 0;
 
 	/* Is this string's data pointer held within the const segment? */
-	unsigned char flagConstSegment : 1;
+	unsigned char flagConstSegment : 1 = 0;
 
 private:
 
@@ -61,6 +81,15 @@ private:
 		length = newLength;
 	}
 
+	/* Sets this string to use the sso buffer with a specified length, and null terminates it.
+	The caller is expected to write the characters directly into the sso buffer. */
+	constexpr void SetSSOLength(size_t len) {
+		flagSSOBuffer = true;
+		flagConstSegment = false;
+		SetLength(len);
+		sso[len] = '\0';
+	}
+
 	/* Sets the sso buffer to a copy of whatever the characters in chars are.
 	Uses len + 1 to include null terminator. Sets the relevant flags. */
 	constexpr void SetSSOBufferChars(const char* chars, size_t len) {
@@ -88,17 +117,85 @@ private:
 		std::copy(chars, &chars[numToCopy + 1], data);
 	}
 
-	/* Attempts to delete the data string. Will not delete under the following conditions.
+	/* Allocates the heap data for len characters and the null terminator. At runtime the buffer comes from string_buffer_pool,
+	and the capacity is rounded up to its size class. Only buffers the pool doesn't keep are recorded as allocations of this string type,
+	as pooled buffers are often reused, and are recorded by alloc_tracker<string_buffer_pool> when actually allocated. */
+	constexpr void AllocateData(size_t len) {
+		alloc_tracker<buffer_string>::RecordHeapSpill();
+		if (!std::is_constant_evaluated() && STRING_BUFFER_POOL) {
+			capacity = string_buffer_pool::RoundCapacity(len + 1);
+			data = string_buffer_pool::Allocate(capacity);
+			if (capacity > string_buffer_pool::LARGEST_CLASS) {
+				alloc_tracker<buffer_string>::RecordAllocation(capacity);
+			}
+		}
+		else {
+			capacity = len + 1;
+			data = new char[capacity];
+			alloc_tracker<buffer_string>::RecordAllocation(capacity);
+		}
+	}
+
+	/* Frees heap data allocated by AllocateData(). */
+	constexpr static void FreeData(char* buffer, size_t bufferCapacity) {
+		if (!std::is_constant_evaluated() && STRING_BUFFER_POOL) {
+			string_buffer_pool::Free(buffer, bufferCapacity);
+			return;
+		}
+		delete[] buffer;
+	}
+
+	/* Whether this string owns heap data. False under the following conditions.
 	1. The string is using the SSO buffer.
 	2. The data pointer is nullptr.
-	3. If the data pointer is in the const segment and not constexpr. */
+	3. If the data pointer is in the const segment, or is an interned symbol, as this string doesn't own it. */
+	[[nodiscard]] constexpr bool OwnsData() const {
+		return !flagSSOBuffer && !flagConstSegment && data != nullptr && data != _emptyString;
+	}
+
+	/* Attempts to delete the data string. Only deletes it if this string owns it. See OwnsData(). */
 	constexpr void TryDeleteDataString() {
-		if (!flagSSOBuffer && data != nullptr && data != _emptyString) {
-			if (!std::is_constant_evaluated() && flagConstSegment) {
-				delete[] data;
-				return;
-			}
-			delete[] data;
+		if (OwnsData()) {
+			FreeData(data, capacity);
+		}
+	}
+
+	/* Makes this string a valid empty string without freeing anything. Used on strings whose heap data has been taken by another string. */
+	constexpr void SetEmptyWithoutData() {
+		SetLength(0);
+		capacity = 0;
+		SetStringToConstSegment(_emptyString);
+	}
+
+	/* Replaces this string's characters with a copy of len characters. Reuses the owned heap data without allocating if it can hold them,
+	otherwise uses the sso buffer or new heap data. The characters may be this string's own. */
+	constexpr void AssignChars(const char* str, size_t len) {
+		if (OwnsData() && len < capacity) {
+			std::char_traits<char>::move(data, str, len);
+			data[len] = '\0';
+			SetLength(len);
+			return;
+		}
+
+		// The old data is freed only after copying, in case the characters are within it.
+		const bool ownedOld = OwnsData();
+		char* oldData = data;
+		const size_t oldCapacity = capacity;
+		if (len <= GetMaxSSOLength()) {
+			alloc_tracker<buffer_string>::RecordSSOHit();
+			std::char_traits<char>::move(sso, str, len);
+			SetSSOLength(len);
+		}
+		else {
+			AllocateData(len);
+			std::copy(str, str + len, data);
+			data[len] = '\0';
+			flagSSOBuffer = false;
+			flagConstSegment = false;
+			SetLength(len);
+		}
+		if (ownedOld) {
+			FreeData(oldData, oldCapacity);
 		}
 	}
 
@@ -108,16 +205,17 @@ private:
 		const size_t len = StrLen(str);
 		SetLength(len);
 		if (!std::is_constant_evaluated() && buffer_string::IsConstCharInConstSegment(str)) {
+			alloc_tracker<buffer_string>::RecordConstSegmentHit();
 			SetStringToConstSegment(str);
 			return;
 		}
 
 		if (len > GetMaxSSOLength()) {
-			capacity = len + 1;
-			data = new char[capacity];
+			AllocateData(len);
 			SetDataChars(str, len);
 		}
 		else {
+			alloc_tracker<buffer_string>::RecordSSOHit();
 			SetSSOBufferChars(str, len);
 		}
 	}
@@ -128,46 +226,75 @@ private:
 		const size_t len = other.Len();
 		const char* str = other.CStr();
 		SetLength(len);
-		if (!std::is_constant_evaluated() && buffer_string::IsConstCharInConstSegment(str)) {
+		if (other.flagConstSegment || (!std::is_constant_evaluated() && buffer_string::IsConstCharInConstSegment(str))) {
+			alloc_tracker<buffer_string>::RecordConstSegmentHit();
 			SetStringToConstSegment(str);
 			return;
 		}
 
 		if (len > GetMaxSSOLength()) {
-			capacity = len + 1;
-			data = new char[capacity];
+			AllocateData(len);
 			SetDataChars(str, len);
 		}
 		else {
+			alloc_tracker<buffer_string>::RecordSSOHit();
 			SetSSOBufferChars(str, len);
 		}
 	}
 
-	/* Performs necessary construction for this string's values from moving another string. Sets the other string data to by nullptr if it's using it. */
+	/* Performs necessary construction for this string's values from moving another string. Takes the other string's heap data along with its full capacity,
+	and leaves the other string as a valid empty string. */
 	inline constexpr void ConstructMove(buffer_string<BUFFER_SIZE>&& other) noexcept
 	{
-		const size_t len = other.Len();
-		const char* str = other.CStr();
-		SetLength(len);
-
-		if (!std::is_constant_evaluated() && buffer_string::IsConstCharInConstSegment(str)) {
-			data = (char*)str;
-			flagSSOBuffer = false;
-			capacity = 0;
-			flagConstSegment = true;
+		if (!other.OwnsData()) {
+			ConstructCopy(other);
+			other.SetEmptyWithoutData();
 			return;
 		}
 
+		SetLength(other.Len());
+		data = other.data;
+		capacity = other.capacity;
+		flagSSOBuffer = false;
+		flagConstSegment = false;
+		other.SetEmptyWithoutData();
+	}
+
+	/* Performs necessary construction for this string to hold len characters that the caller writes directly.
+	Uses the sso buffer if they fit, otherwise allocates heap data for at least len + 1. Writes the null terminator.
+	@return Pointer to write the len characters into. */
+	inline constexpr char* ConstructForWrite(size_t len)
+	{
 		if (len > GetMaxSSOLength()) {
-			capacity = len + 1;
-			data = (char*)str;
-			other.data = nullptr;
+			SetLength(len);
+			AllocateData(len);
 			flagSSOBuffer = false;
-
+			flagConstSegment = false;
+			data[len] = '\0';
+			return data;
 		}
-		else {
-			SetSSOBufferChars(str, len);
+		alloc_tracker<buffer_string>::RecordSSOHit();
+		SetSSOLength(len);
+		return sso;
+	}
+
+	/* Copy on write for strings pointing to the const data segment. Copies the characters into the sso buffer or a new heap allocation so they can be modified.
+	Does nothing for strings that already own their characters. */
+	constexpr void MakeMutable() {
+		if (!flagConstSegment) return;
+
+		const char* str = data;
+		const size_t len = Len();
+		char* out = ConstructForWrite(len);
+		std::copy(str, str + len, out);
+	}
+
+	/* Pointer to the owned characters. Assumes MakeMutable() has been called. */
+	[[nodiscard]] constexpr char* MutableData() {
+		if (!flagSSOBuffer) {
+			return data;
 		}
+		return sso;
 	}
 
 public:
@@ -186,21 +313,145 @@ public:
 #endif
 	}
 
+	/* Create a string pointing at characters that outlive it, such as a symbol from a concurrent_symbol_table, without copying them.
+	The string is treated like one in the const segment, so strings of the same symbol compare equal by pointer, and copies share the characters.
+	@param str: Null terminated characters that must stay valid for the lifetime of the string and its copies. */
+	[[nodiscard]] constexpr static buffer_string FromInterned(const char* str, size_t len) {
+		buffer_string interned;
+		interned.SetLength(len);
+		interned.SetStringToConstSegment(str);
+		return interned;
+	}
+
 	/* Check the length of a const char*
 	TODO SIMD / SSE / AVX optimizations. */
 	[[nodiscard]] constexpr static size_t StrLen(const char* str) {
 		return std::char_traits<char>::length(str);
 	}
 
-	/* Check if two character arrays are equal.
-	TODO SIMD / SSE / AVX optimizations. */
+	/* Check if two character arrays are equal. Compares 32 bytes per step with AVX2 when available. */
 	[[nodiscard]] constexpr static bool StrEqual(const char* str1, const char* str2, size_t num) {
-		for (int i = 0; i < num; i++) {
-			if (str1[i] != str2[i]) {
-				return false;
+		return string_simd::FindMismatch(str1, str2, num) == num;
+	}
+
+	/* The maximum number of characters FormatUnsigned() and FormatSigned() can write. */
+	static constexpr size_t MAX_INTEGER_CHARS = 20;
+
+	/* The maximum number of characters the shortest round trip representation of a double can take. */
+	static constexpr size_t MAX_DOUBLE_CHARS = 24;
+
+	/* Write the decimal representation of an unsigned integer, two digits at a time. Does not write a null terminator.
+	@param out: Destination. Must have room for at least MAX_INTEGER_CHARS characters.
+	@return The number of characters written. */
+	constexpr static size_t FormatUnsigned(char* out, unsigned long long num) {
+		size_t digits = 1;
+		for (unsigned long long n = num; n >= 10; n /= 10) {
+			digits++;
+		}
+
+		size_t pos = digits;
+		while (num >= 100) {
+			const size_t pair = (num % 100) * 2;
+			num /= 100;
+			out[--pos] = _digitPairs[pair + 1];
+			out[--pos] = _digitPairs[pair];
+		}
+		if (num >= 10) {
+			out[--pos] = _digitPairs[num * 2 + 1];
+			out[--pos] = _digitPairs[num * 2];
+		}
+		else {
+			out[--pos] = char('0' + num);
+		}
+		return digits;
+	}
+
+	/* Write the decimal representation of a signed integer, two digits at a time. Does not write a null terminator.
+	@param out: Destination. Must have room for at least MAX_INTEGER_CHARS characters.
+	@return The number of characters written. */
+	constexpr static size_t FormatSigned(char* out, long long num) {
+		if (num >= 0) {
+			return FormatUnsigned(out, (unsigned long long)num);
+		}
+		out[0] = '-';
+		return FormatUnsigned(out + 1, 0ULL - (unsigned long long)num) + 1;
+	}
+
+	/* Create a string holding the decimal representation of an integer. Always fits within the sso buffer, so never allocates. */
+	template<typename T>
+		requires (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+	[[nodiscard]] constexpr static buffer_string From(T num) {
+		buffer_string str;
+		size_t len;
+		if constexpr (std::is_signed_v<T>) {
+			len = FormatSigned(str.sso, (long long)num);
+		}
+		else {
+			len = FormatUnsigned(str.sso, (unsigned long long)num);
+		}
+		str.SetSSOLength(len);
+		return str;
+	}
+
+	/* Create a string holding the shortest round trip representation of a double. Always fits within the sso buffer, so never allocates.
+	Not constexpr valid. */
+	[[nodiscard]] static buffer_string From(double num) {
+		buffer_string str;
+		const std::to_chars_result result = std::to_chars(str.sso, str.sso + MAX_DOUBLE_CHARS, num);
+		str.SetSSOLength(size_t(result.ptr - str.sso));
+		return str;
+	}
+
+	/* Parse this entire string as a number. Integer parsing is constexpr valid. Floating point parsing is not.
+	Throws std::invalid_argument if the string is not entirely a number, and std::out_of_range if it doesn't fit in T. */
+	template<typename T>
+		requires ((std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_floating_point_v<T>)
+	[[nodiscard]] constexpr T Parse() const {
+		const char* str = CStr();
+		const char* end = str + Len();
+
+		if constexpr (std::is_floating_point_v<T>) {
+			T num{};
+			const std::from_chars_result result = std::from_chars(str, end, num);
+			if (result.ec == std::errc::result_out_of_range) {
+				throw std::out_of_range("String Parse() number does not fit in the requested type!");
+			}
+			if (result.ec != std::errc() || result.ptr != end) {
+				throw std::invalid_argument("String Parse() is not a valid number!");
 			}
+			return num;
 		}
-		return true;
+		else {
+			bool negative = false;
+			if (str != end && (*str == '-' || *str == '+')) {
+				negative = *str == '-';
+				str++;
+			}
+			if (str == end || (negative && std::is_unsigned_v<T>)) {
+				throw std::invalid_argument("String Parse() is not a valid integer!");
+			}
+
+			using U = std::make_unsigned_t<T>;
+			const U limit = std::is_signed_v<T> ? U(U(std::numeric_limits<T>::max()) + U(negative)) : std::numeric_limits<U>::max();
+			U num = 0;
+			for (; str != end; str++) {
+				const unsigned char digit = (unsigned char)(*str - '0');
+				if (digit > 9) {
+					throw std::invalid_argument("String Parse() is not a valid integer!");
+				}
+				if (num > (limit - digit) / 10) {
+					throw std::out_of_range("String Parse() integer does not fit in the requested type!");
+				}
+				num = U(num * 10 + digit);
+			}
+			return negative ? T(U(0) - num) : T(num);
+		}
+	}
+
+	/* 64 bit FNV-1a hash of a character array. Used by Hash(), and the _hs string literal in string_hash.h.
+	Same as string_simd::Hash(), so fixed_string hashes match. */
+	[[nodiscard]] constexpr static unsigned long long HashChars(const char* str, size_t len) {
+		return string_simd::Hash(str, len);
 	}
 
 	/**/
@@ -237,27 +488,62 @@ public:
 		TryDeleteDataString();
 	}
 
-	/**/
+	/* Copies the characters into the heap data this string already owns if they fit, so reassigning a string never allocates once it is large enough. */
 	constexpr buffer_string<BUFFER_SIZE>& operator = (const char* str)
 	{
-		TryDeleteDataString();
-		ConstructConstChar(str);
+		if (!std::is_constant_evaluated() && buffer_string::IsConstCharInConstSegment(str)) {
+			TryDeleteDataString();
+			ConstructConstChar(str);
+			return *this;
+		}
+		AssignChars(str, StrLen(str));
 		return *this;
 	}
 
-	/**/
+	/* Copies the characters into the heap data this string already owns if they fit, so reassigning a string never allocates once it is large enough. */
 	constexpr buffer_string<BUFFER_SIZE>& operator = (const buffer_string<BUFFER_SIZE>& other)
 	{
-		TryDeleteDataString();
-		ConstructCopy(other);
+		if (this == &other) return *this;
+
+		if (other.flagConstSegment) {
+			TryDeleteDataString();
+			ConstructCopy(other);
+			return *this;
+		}
+		AssignChars(other.CStr(), other.Len());
 		return *this;
 	}
 
-	/**/
+	/* Takes the other string's heap data along with its full capacity. This string's own heap data is given to the other string rather than freed,
+	which leaves the other string empty but able to be refilled without allocating. Otherwise copies the characters as in copy assignment,
+	and leaves the other string as a valid empty string. */
 	constexpr buffer_string<BUFFER_SIZE>& operator = (buffer_string<BUFFER_SIZE>&& other) noexcept
 	{
-		TryDeleteDataString();
-		ConstructMove(std::move(other));
+		if (this == &other) return *this;
+
+		if (!other.OwnsData()) {
+			*this = other;
+			other.SetEmptyWithoutData();
+			return *this;
+		}
+
+		const bool ownedOld = OwnsData();
+		char* oldData = data;
+		const size_t oldCapacity = capacity;
+		SetLength(other.Len());
+		data = other.data;
+		capacity = other.capacity;
+		flagSSOBuffer = false;
+		flagConstSegment = false;
+		if (ownedOld) {
+			other.SetLength(0);
+			other.data = oldData;
+			other.capacity = oldCapacity;
+			oldData[0] = '\0';
+		}
+		else {
+			other.SetEmptyWithoutData();
+		}
 		return *this;
 	}
 
@@ -267,6 +553,13 @@ public:
 	/* Whether this string is currently pointing to data in the const data segment. */
 	[[nodiscard]] constexpr bool IsConstSegment() const { return flagConstSegment; }
 
+	/* Get the number of characters, including the null terminator, this string can hold without allocating.
+	The size of the sso buffer, the capacity of owned heap data, or 0 for strings pointing to the const data segment. */
+	[[nodiscard]] constexpr size_t Capacity() const {
+		if (flagSSOBuffer) return BUFFER_SIZE;
+		return OwnsData() ? capacity : 0;
+	}
+
 	/* Get the length of this string. */
 	[[nodiscard]] constexpr size_t Len() const { return length; }
 
@@ -279,18 +572,187 @@ public:
 	}
 
 	/**/
-	[[nodiscard]] constexpr bool IsEmpty() const { Len() == 0; }
+	[[nodiscard]] constexpr bool IsEmpty() const { return Len() == 0; }
 
-	/* Get a character at a specified index. Not a reference to the character though. */
-	[[nodiscard]] constexpr char At(size_t index) {
+	/* Get a character at a specified index. Not a reference to the character though. Bounds checked according to CONTAINER_CHECK_POLICY. */
+	[[nodiscard]] constexpr char At(size_t index) const {
+		bounds_check::Index(index, Len(), "String At() index is out of bounds!");
 		return CStr()[index];
 	}
 
-	/* Get a character at a specified index. Not a reference to the character though. */
-	[[nodiscard]] constexpr char operator[](size_t index) {
+	/* Get a character at a specified index. Not a reference to the character though. Same as At(). */
+	[[nodiscard]] constexpr char operator[](size_t index) const {
 		return At(index);
 	}
 
+	/* Get the hash of this string's characters. Equal to the _hs literal of the same characters. */
+	[[nodiscard]] constexpr unsigned long long Hash() const {
+		return HashChars(CStr(), Len());
+	}
+
+	/* Whether this string's characters are entirely valid UTF-8. Rejects overlong encodings, surrogates, code points above U+10FFFF, and truncated sequences.
+	Uses AVX2 at runtime when available. */
+	[[nodiscard]] constexpr bool IsValidUtf8() const {
+		return utf8::IsValid(CStr(), Len());
+	}
+
+	/* Get the number of unicode code points in this string. Assumes the string is valid UTF-8. */
+	[[nodiscard]] constexpr size_t CodepointCount() const {
+		return utf8::CodepointCount(CStr(), Len());
+	}
+
+	/* Get a range over the code points of this string, for range based for loops. Invalid sequences produce U+FFFD. */
+	[[nodiscard]] constexpr utf8_codepoint_range Codepoints() const {
+		return utf8_codepoint_range{ CStr(), Len() };
+	}
+
+	/* Get a lazy range of the fields of this string separated by a delimiter, as non-owning string views. Consecutive delimiters produce empty fields,
+	and a string without the delimiter is a single field. Delimiters are found 32 characters at a time with AVX2 at runtime when available.
+	The views are invalidated when this string is modified or destroyed. */
+	[[nodiscard]] constexpr string_split_range Split(char delimiter) const {
+		return string_split_range{ string_delimiter_scanner(CStr(), Len(), nullptr, 1, delimiter), false };
+	}
+
+	/* Get a lazy range of the tokens of this string separated by any of a set of delimiter characters, as non-owning string views.
+	Empty tokens are skipped, so consecutive delimiters count as one. The views are invalidated when this string is modified or destroyed.
+	@param delimiters: Null terminated set of delimiter characters. Must outlive the range. */
+	[[nodiscard]] constexpr string_split_range Tokenize(const char* delimiters) const {
+		return string_split_range{ string_delimiter_scanner(CStr(), Len(), delimiters, StrLen(delimiters), '\0'), true };
+	}
+
+	/* Transcode this string to UTF-16. Throws std::invalid_argument if this string is not valid UTF-8. */
+	[[nodiscard]] constexpr darray<char16_t> ToUtf16() const {
+		if (!IsValidUtf8()) {
+			throw std::invalid_argument("String ToUtf16() is not valid UTF-8!");
+		}
+		const char* str = CStr();
+		const size_t len = Len();
+		darray<char16_t> out;
+		out.Reserve(arrint(len));
+		size_t index = 0;
+		while (index < len) {
+			const char32_t codepoint = utf8::DecodeNext(str, len, index);
+			if (codepoint < 0x10000) {
+				out.Add(char16_t(codepoint));
+			}
+			else {
+				out.Add(char16_t(0xD800 + ((codepoint - 0x10000) >> 10)));
+				out.Add(char16_t(0xDC00 + ((codepoint - 0x10000) & 0x3FF)));
+			}
+		}
+		return out;
+	}
+
+	/* Transcode this string to UTF-32. Throws std::invalid_argument if this string is not valid UTF-8. */
+	[[nodiscard]] constexpr darray<char32_t> ToUtf32() const {
+		if (!IsValidUtf8()) {
+			throw std::invalid_argument("String ToUtf32() is not valid UTF-8!");
+		}
+		const char* str = CStr();
+		const size_t len = Len();
+		darray<char32_t> out;
+		out.Reserve(arrint(CodepointCount()));
+		size_t index = 0;
+		while (index < len) {
+			out.Add(utf8::DecodeNext(str, len, index));
+		}
+		return out;
+	}
+
+	/* Create a UTF-8 string from UTF-16 characters. Writes directly into the sso buffer if the result fits.
+	Throws std::invalid_argument on unpaired surrogates. */
+	[[nodiscard]] constexpr static buffer_string FromUtf16(const char16_t* chars, size_t len) {
+		// First pass validates surrogate pairs and finds the exact UTF-8 length.
+		size_t utf8Len = 0;
+		for (size_t i = 0; i < len; i++) {
+			const char16_t c = chars[i];
+			if (c >= 0xD800 && c <= 0xDBFF) {
+				if (i + 1 == len || chars[i + 1] < 0xDC00 || chars[i + 1] > 0xDFFF) {
+					throw std::invalid_argument("String FromUtf16() has an unpaired surrogate!");
+				}
+				utf8Len += 4;
+				i++;
+			}
+			else if (c >= 0xDC00 && c <= 0xDFFF) {
+				throw std::invalid_argument("String FromUtf16() has an unpaired surrogate!");
+			}
+			else {
+				utf8Len += utf8::EncodedLength(c);
+			}
+		}
+
+		buffer_string str;
+		char* out = str.ConstructForWrite(utf8Len);
+		for (size_t i = 0; i < len; i++) {
+			char32_t codepoint = chars[i];
+			if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+				codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (char32_t(chars[i + 1]) - 0xDC00);
+				i++;
+			}
+			out += utf8::Encode(codepoint, out);
+		}
+		return str;
+	}
+
+	/* Create a UTF-8 string from UTF-32 characters. Writes directly into the sso buffer if the result fits.
+	Throws std::invalid_argument on surrogates or code points above U+10FFFF. */
+	[[nodiscard]] constexpr static buffer_string FromUtf32(const char32_t* chars, size_t len) {
+		size_t utf8Len = 0;
+		for (size_t i = 0; i < len; i++) {
+			const size_t encodedLen = utf8::EncodedLength(chars[i]);
+			if (encodedLen == 0) {
+				throw std::invalid_argument("String FromUtf32() has an invalid code point!");
+			}
+			utf8Len += encodedLen;
+		}
+
+		buffer_string str;
+		char* out = str.ConstructForWrite(utf8Len);
+		for (size_t i = 0; i < len; i++) {
+			out += utf8::Encode(chars[i], out);
+		}
+		return str;
+	}
+
+	/* Converts every ASCII upper case character to lower case in place. Strings pointing to the const data segment are copied first. */
+	constexpr void ToLower() {
+		MakeMutable();
+		string_simd::ToLower(MutableData(), Len());
+	}
+
+	/* Converts every ASCII lower case character to upper case in place. Strings pointing to the const data segment are copied first. */
+	constexpr void ToUpper() {
+		MakeMutable();
+		string_simd::ToUpper(MutableData(), Len());
+	}
+
+	/* Check if this string is equal to a const char*, ignoring ASCII case. */
+	[[nodiscard]] constexpr bool EqualsIgnoreCase(const char* str) const {
+		const size_t len = StrLen(str);
+		return Len() == len && string_simd::CompareIgnoreCase(CStr(), str, len) == 0;
+	}
+
+	/* Check if this string is equal to another string, ignoring ASCII case. */
+	[[nodiscard]] constexpr bool EqualsIgnoreCase(const buffer_string<BUFFER_SIZE>& other) const {
+		return Len() == other.Len() && string_simd::CompareIgnoreCase(CStr(), other.CStr(), Len()) == 0;
+	}
+
+	/* Lexicographically compare this string with another, ignoring ASCII case.
+	@return Negative if this string orders first, positive if other orders first, or 0 if they are equal ignoring case. */
+	[[nodiscard]] constexpr int CompareIgnoreCase(const buffer_string<BUFFER_SIZE>& other) const {
+		const size_t len = Len() < other.Len() ? Len() : other.Len();
+		const int result = string_simd::CompareIgnoreCase(CStr(), other.CStr(), len);
+		if (result != 0) {
+			return result;
+		}
+		return Len() < other.Len() ? -1 : (Len() > other.Len() ? 1 : 0);
+	}
+
+	/* Get the hash of this string ignoring ASCII case. Strings that are EqualsIgnoreCase() have the same hash. */
+	[[nodiscard]] constexpr unsigned long long HashIgnoreCase() const {
+		return string_simd::HashIgnoreCase(CStr(), Len());
+	}
+
 	/* Check if this string is equal to a const char*. Can check if they are within the const data segment and bypass most string checks. */
 	[[nodiscard]] constexpr bool operator == (const char* str) const
 	{
@@ -321,6 +783,19 @@ public:
 		return StrEqual(CStr(), other.CStr(), len);
 	}
 
+	/* Lexicographically order this string with another, comparing characters as unsigned bytes. Compares the first 8 characters
+	as a single integer, then finds the first mismatch 32 bytes per step. */
+	[[nodiscard]] constexpr std::strong_ordering operator <=> (const buffer_string<BUFFER_SIZE>& other) const
+	{
+		return string_simd::Compare(CStr(), Len(), other.CStr(), other.Len()) <=> 0;
+	}
+
+	/* Lexicographically order this string with a const char*, comparing characters as unsigned bytes. */
+	[[nodiscard]] constexpr std::strong_ordering operator <=> (const char* str) const
+	{
+		return string_simd::Compare(CStr(), Len(), str, StrLen(str)) <=> 0;
+	}
+
 	/* std::cout << string */
 	friend std::ostream& operator << (std::ostream& os, const buffer_string<BUFFER_SIZE>& _string) {
 		return os << _string.CStr();
@@ -330,4 +805,31 @@ public:
 
 /* A constexpr, sso, and const segment enabled string class. Can check if const char*'s passed in exist within the application const data segment,
 and avoid doing unnecessary copying with this. Has an internal sso buffer size of 32. */
-typedef buffer_string<32> string;
\ No newline at end of file
+typedef buffer_string<32> string;
+
+/* Case insensitive hash for buffer_string keys. Use with string_equal_ignore_case, for example std::unordered_map<string, V, string_hash_ignore_case, string_equal_ignore_case>. */
+struct string_hash_ignore_case
+{
+	template<size_t BUFFER_SIZE>
+	constexpr size_t operator()(const buffer_string<BUFFER_SIZE>& str) const {
+		return (size_t)str.HashIgnoreCase();
+	}
+};
+
+/* Case insensitive equality for buffer_string keys. Use with string_hash_ignore_case. */
+struct string_equal_ignore_case
+{
+	template<size_t BUFFER_SIZE>
+	constexpr bool operator()(const buffer_string<BUFFER_SIZE>& str1, const buffer_string<BUFFER_SIZE>& str2) const {
+		return str1.EqualsIgnoreCase(str2);
+	}
+};
+
+/* Allows buffer_string to be used as a key in std::unordered_map and similar. */
+template<size_t BUFFER_SIZE>
+struct std::hash<buffer_string<BUFFER_SIZE>>
+{
+	size_t operator()(const buffer_string<BUFFER_SIZE>& str) const {
+		return (size_t)str.Hash();
+	}
+};
\ No newline at end of file
@@ -0,0 +1,330 @@
+#pragma once
+
+#include "string.h"
+#include <string_view>
+
+#ifdef _MSC_VER
+#include <io.h>
+#else
+#include <cerrno>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <climits>
+#endif
+
+/* Fixed size block of characters used by string_builder. */
+struct string_chunk
+{
+	/* Number of characters a single chunk holds. Keeps the whole chunk at 4KB. */
+	static constexpr size_t CAPACITY = 4096 - sizeof(string_chunk*) - sizeof(size_t);
+
+	/* Next chunk in the chain, or nullptr if this is the last. */
+	string_chunk* next;
+
+	/* Number of characters written into this chunk. */
+	size_t used;
+
+	char chars[CAPACITY];
+};
+
+/* Per-thread free list of string chunks, so that building strings repeatedly doesn't go back to the heap for every chunk. Not constexpr valid. */
+struct string_chunk_pool
+{
+	/* Maximum number of free chunks kept per thread. Anything past this is deleted. */
+	static constexpr size_t MAX_FREE_CHUNKS = 64;
+
+	/* @return A chunk from the calling thread's pool, or a newly allocated chunk if the pool is empty. */
+	[[nodiscard]] static string_chunk* Acquire() {
+		string_chunk_pool& pool = Get();
+		if (pool.freeList == nullptr) {
+			alloc_tracker<string_chunk>::RecordAllocation(sizeof(string_chunk));
+			return new string_chunk;
+		}
+		string_chunk* chunk = pool.freeList;
+		pool.freeList = chunk->next;
+		pool.freeCount--;
+		return chunk;
+	}
+
+	/* Returns a chunk to the calling thread's pool. */
+	static void Release(string_chunk* chunk) {
+		string_chunk_pool& pool = Get();
+		if (pool.freeCount == MAX_FREE_CHUNKS) {
+			delete chunk;
+			return;
+		}
+		chunk->next = pool.freeList;
+		pool.freeList = chunk;
+		pool.freeCount++;
+	}
+
+	~string_chunk_pool() {
+		while (freeList != nullptr) {
+			string_chunk* next = freeList->next;
+			delete freeList;
+			freeList = next;
+		}
+	}
+
+private:
+
+	string_chunk* freeList = nullptr;
+
+	size_t freeCount = 0;
+
+	static string_chunk_pool& Get() {
+		thread_local string_chunk_pool pool;
+		return pool;
+	}
+
+};
+
+/* Builds large strings by appending into a chain of fixed size chunks, so no existing characters are ever reallocated or copied while appending.
+Chunks come from a per-thread pool at runtime. The chunks can be written out directly with WriteTo(), or turned into a single string with Finish(). */
+struct string_builder
+{
+private:
+
+	string_chunk* head;
+
+	string_chunk* tail;
+
+	size_t length;
+
+	[[nodiscard]] constexpr static string_chunk* AcquireChunk() {
+		string_chunk* chunk;
+		if (std::is_constant_evaluated()) {
+			chunk = new string_chunk;
+		}
+		else {
+			chunk = string_chunk_pool::Acquire();
+		}
+		chunk->next = nullptr;
+		chunk->used = 0;
+		return chunk;
+	}
+
+	constexpr static void ReleaseChunk(string_chunk* chunk) {
+		if (std::is_constant_evaluated()) {
+			delete chunk;
+		}
+		else {
+			string_chunk_pool::Release(chunk);
+		}
+	}
+
+	/* Adds a new empty chunk to the end of the chain. */
+	constexpr void AddChunk() {
+		string_chunk* chunk = AcquireChunk();
+		if (tail == nullptr) {
+			head = chunk;
+		}
+		else {
+			tail->next = chunk;
+		}
+		tail = chunk;
+	}
+
+	/* @return Pointer to at least minimumChars of contiguous writable space at the end of the last chunk.
+	Starts a new chunk if the last one doesn't have enough space. */
+	constexpr char* ReserveContiguous(size_t minimumChars) {
+		if (tail == nullptr || string_chunk::CAPACITY - tail->used < minimumChars) {
+			AddChunk();
+		}
+		return tail->chars + tail->used;
+	}
+
+	/* Marks chars written into the space returned by ReserveContiguous() as used. */
+	constexpr void CommitContiguous(size_t chars) {
+		tail->used += chars;
+		length += chars;
+	}
+
+public:
+
+	constexpr string_builder()
+		: head(nullptr), tail(nullptr), length(0)
+	{}
+
+	string_builder(const string_builder&) = delete;
+
+	string_builder& operator = (const string_builder&) = delete;
+
+	constexpr string_builder(string_builder&& other) noexcept
+		: head(other.head), tail(other.tail), length(other.length)
+	{
+		other.head = nullptr;
+		other.tail = nullptr;
+		other.length = 0;
+	}
+
+	constexpr ~string_builder() {
+		Clear();
+	}
+
+	/* Returns this builder's chunks to the pool, then takes the other builder's chunks. The other builder is left empty. */
+	constexpr string_builder& operator = (string_builder&& other) noexcept {
+		if (this == &other) return *this;
+		Clear();
+		head = other.head;
+		tail = other.tail;
+		length = other.length;
+		other.head = nullptr;
+		other.tail = nullptr;
+		other.length = 0;
+		return *this;
+	}
+
+	/* Get the total number of characters appended. */
+	[[nodiscard]] constexpr size_t Len() const { return length; }
+
+	/* Removes all characters, returning every chunk to the pool. */
+	constexpr void Clear() {
+		while (head != nullptr) {
+			string_chunk* next = head->next;
+			ReleaseChunk(head);
+			head = next;
+		}
+		tail = nullptr;
+		length = 0;
+	}
+
+	/* Appends a number of characters, filling the current chunk before starting new ones. */
+	constexpr void Append(const char* chars, size_t len) {
+		while (len > 0) {
+			if (tail == nullptr || tail->used == string_chunk::CAPACITY) {
+				AddChunk();
+			}
+			const size_t space = string_chunk::CAPACITY - tail->used;
+			const size_t toCopy = len < space ? len : space;
+			std::copy(chars, chars + toCopy, tail->chars + tail->used);
+			tail->used += toCopy;
+			length += toCopy;
+			chars += toCopy;
+			len -= toCopy;
+		}
+	}
+
+	/* Appends a null terminated const char*. */
+	constexpr void Append(const char* str) {
+		Append(str, string::StrLen(str));
+	}
+
+	/* Appends a string view without copying it anywhere else first. */
+	constexpr void Append(std::string_view view) {
+		Append(view.data(), view.size());
+	}
+
+	/* Appends the characters of a string. */
+	template<size_t BUFFER_SIZE>
+	constexpr void Append(const buffer_string<BUFFER_SIZE>& str) {
+		Append(str.CStr(), str.Len());
+	}
+
+	/* Appends a single character. */
+	constexpr void Append(char c) {
+		*ReserveContiguous(1) = c;
+		CommitContiguous(1);
+	}
+
+	/* Appends the decimal representation of an integer, formatted directly into the chunk. */
+	template<typename T>
+		requires (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+	constexpr void Append(T num) {
+		char* out = ReserveContiguous(string::MAX_INTEGER_CHARS);
+		if constexpr (std::is_signed_v<T>) {
+			CommitContiguous(string::FormatSigned(out, (long long)num));
+		}
+		else {
+			CommitContiguous(string::FormatUnsigned(out, (unsigned long long)num));
+		}
+	}
+
+	/* Appends the shortest round trip representation of a double, formatted directly into the chunk. Not constexpr valid. */
+	void Append(double num) {
+		char* out = ReserveContiguous(string::MAX_DOUBLE_CHARS);
+		const std::to_chars_result result = std::to_chars(out, out + string::MAX_DOUBLE_CHARS, num);
+		CommitContiguous(size_t(result.ptr - out));
+	}
+
+	/* Calls func(const char* chars, size_t len) for every non-empty chunk in order. Useful for gathering the chunks into any output. */
+	template<typename Func>
+	constexpr void ForEachChunk(Func&& func) const {
+		for (const string_chunk* chunk = head; chunk != nullptr; chunk = chunk->next) {
+			if (chunk->used > 0) {
+				func((const char*)chunk->chars, chunk->used);
+			}
+		}
+	}
+
+	/* Creates a single string from all the chunks. Does a single allocation if it doesn't fit in the sso buffer. At runtime the capacity is rounded up to a
+	string_buffer_pool size class of 64, 128, 256 or 512 bytes when the characters and null terminator fit in 512 bytes. */
+	template<size_t BUFFER_SIZE = 32>
+	[[nodiscard]] constexpr buffer_string<BUFFER_SIZE> Finish() const {
+		buffer_string<BUFFER_SIZE> str;
+		char* out = str.ConstructForWrite(length);
+		ForEachChunk([&out](const char* chars, size_t len) {
+			std::copy(chars, chars + len, out);
+			out += len;
+		});
+		return str;
+	}
+
+	/* Writes every chunk to a file descriptor without copying them into a single buffer first. Uses writev() scatter/gather output where available.
+	Not constexpr valid.
+	@return If all characters were successfully written. */
+	bool WriteTo(int fileDescriptor) const {
+#ifdef _MSC_VER
+		bool success = true;
+		ForEachChunk([&](const char* chars, size_t len) {
+			// _write() may write fewer bytes than requested, so keep writing the rest.
+			while (success && len > 0) {
+				const int written = _write(fileDescriptor, chars, (unsigned int)len);
+				if (written <= 0) {
+					success = false;
+					break;
+				}
+				chars += written;
+				len -= size_t(written);
+			}
+		});
+		return success;
+#else
+		constexpr int MAX_IOVECS = IOV_MAX < 64 ? IOV_MAX : 64;
+		iovec iovecs[MAX_IOVECS];
+		const string_chunk* chunk = head;
+		size_t chunkOffset = 0;
+
+		while (chunk != nullptr) {
+			int count = 0;
+			for (const string_chunk* c = chunk; c != nullptr && count < MAX_IOVECS; c = c->next) {
+				const size_t offset = c == chunk ? chunkOffset : 0;
+				if (c->used == offset) continue;
+				iovecs[count].iov_base = (void*)(c->chars + offset);
+				iovecs[count].iov_len = c->used - offset;
+				count++;
+			}
+			if (count == 0) {
+				return true;
+			}
+
+			ssize_t written = writev(fileDescriptor, iovecs, count);
+			if (written < 0) {
+				// Interrupted by a signal before anything was written, so try again.
+				if (errno == EINTR) continue;
+				return false;
+			}
+
+			// Advance past everything written, which may end partway through a chunk.
+			while (chunk != nullptr && written >= ssize_t(chunk->used - chunkOffset)) {
+				written -= ssize_t(chunk->used - chunkOffset);
+				chunk = chunk->next;
+				chunkOffset = 0;
+			}
+			chunkOffset += size_t(written);
+		}
+		return true;
+#endif
+	}
+
+};
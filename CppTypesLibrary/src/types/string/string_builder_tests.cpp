@@ -0,0 +1,103 @@
+#include "string_builder.h"
+
+#define TEST_TYPES "String Builder"
+#include <testframework/unit_test_compile_time.h>
+
+namespace StringBuilderUnitTests
+{
+
+#pragma region Append
+
+	constexpr bool AppendEmpty() {
+		string_builder builder;
+		return builder.Len() == 0 && builder.Finish() == "";
+	}
+	TEST_ASSERT(AppendEmpty(), "Empty string builder does not finish as an empty string");
+
+	constexpr bool AppendPieces() {
+		string_builder builder;
+		string s = "world";
+		builder.Append("hello ");
+		builder.Append(s);
+		builder.Append(std::string_view(", it is"));
+		builder.Append(' ');
+		builder.Append(-42);
+		builder.Append(7u);
+		return builder.Finish() == "hello world, it is -427";
+	}
+	TEST_ASSERT(AppendPieces(), "String builder does not append strings, views, characters, and integers correctly");
+
+	constexpr bool AppendLength() {
+		string_builder builder;
+		builder.Append("abc");
+		builder.Append(1234);
+		return builder.Len() == 7;
+	}
+	TEST_ASSERT(AppendLength(), "String builder has an incorrect length after appending");
+
+#pragma endregion
+
+#pragma region Chunks
+
+	constexpr bool AppendAcrossChunks() {
+		string_builder builder;
+		const char* text = "0123456789abcdefghijklmnopqrstuvwxyz";
+		const size_t appends = (string_chunk::CAPACITY * 3) / 36 + 1;
+		for (size_t i = 0; i < appends; i++) {
+			builder.Append(text, 36);
+		}
+
+		size_t chunkCount = 0;
+		builder.ForEachChunk([&chunkCount](const char*, size_t) { chunkCount++; });
+
+		string result = builder.Finish();
+		if (result.Len() != appends * 36 || chunkCount != 4) return false;
+		for (size_t i = 0; i < result.Len(); i++) {
+			if (result.CStr()[i] != text[i % 36]) return false;
+		}
+		return true;
+	}
+	TEST_ASSERT(AppendAcrossChunks(), "String builder does not keep characters in order across multiple chunks");
+
+	constexpr bool ClearReuse() {
+		string_builder builder;
+		builder.Append("this is some text that will be cleared");
+		builder.Clear();
+		builder.Append("new");
+		return builder.Len() == 3 && builder.Finish() == "new";
+	}
+	TEST_ASSERT(ClearReuse(), "String builder does not reset correctly after being cleared");
+
+	constexpr bool MoveAssign() {
+		string_builder builder;
+		builder.Append("chunks that are released when assigned over");
+		string_builder other;
+		other.Append("moved");
+		builder = std::move(other);
+		other.Append("again");
+		return builder.Len() == 5 && builder.Finish() == "moved" && other.Len() == 5 && other.Finish() == "again";
+	}
+	TEST_ASSERT(MoveAssign(), "String builder move assignment does not take the other builder's chunks");
+
+#pragma endregion
+
+#pragma region Finish
+
+	constexpr bool FinishSmallIsSSO() {
+		string_builder builder;
+		builder.Append("small");
+		return builder.Finish().IsSSO();
+	}
+	TEST_ASSERT(FinishSmallIsSSO(), "String builder finishing a small string does not use the sso buffer");
+
+	constexpr bool FinishLargeNotSSO() {
+		string_builder builder;
+		builder.Append("this string is definitely too long for sso");
+		string s = builder.Finish();
+		return !s.IsSSO() && s == "this string is definitely too long for sso";
+	}
+	TEST_ASSERT(FinishLargeNotSSO(), "String builder finishing a large string is incorrect");
+
+#pragma endregion
+
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "string.h"
+#include <bit>
+
+/* Compile time hash of a string literal. Equal to buffer_string::Hash() of the same characters, so it can be used for switch cases.
+Example: switch (str.Hash()) { case "run"_hs: ... } */
+constexpr unsigned long long operator""_hs(const char* str, size_t len) {
+	return string::HashChars(str, len);
+}
+
+/* Compile time built perfect hash table over a fixed set of string keys. Looking up any string costs one hash,
+one table read, and a single verifying compare against the only key that could match.
+Example: constexpr perfect_hash_table commands({ "run", "stop", "pause" });
+switch (commands.Find(str)) { case commands.IndexOf("run"): ... }
+@param KEY_COUNT: Number of keys held within the table. */
+template<size_t KEY_COUNT>
+struct perfect_hash_table
+{
+	static_assert(KEY_COUNT > 0, "perfect hash table must have at least 1 key");
+
+	/* Keys are distributed into buckets, each having its own seed chosen so that none of the keys collide. */
+	static constexpr size_t BUCKET_COUNT = std::bit_ceil(KEY_COUNT);
+
+	/* Number of slots. Kept at twice the bucket count so that seeds are found quickly at compile time. */
+	static constexpr size_t TABLE_SIZE = BUCKET_COUNT * 2;
+
+	/* Returned by Find() when the string is not one of the keys. */
+	static constexpr int NOT_FOUND = -1;
+
+private:
+
+	const char* keys[KEY_COUNT];
+
+	size_t keyLengths[KEY_COUNT];
+
+	unsigned long long hashes[KEY_COUNT];
+
+	unsigned long long seeds[BUCKET_COUNT];
+
+	/* Index into keys, or NOT_FOUND for empty slots. */
+	int slots[TABLE_SIZE];
+
+	constexpr static size_t BucketOf(unsigned long long hash) {
+		return size_t(hash & (BUCKET_COUNT - 1));
+	}
+
+	constexpr static size_t SlotOf(unsigned long long hash, unsigned long long seed) {
+		unsigned long long h = hash ^ (seed * 0x9E3779B97F4A7C15ULL);
+		h ^= h >> 33;
+		h *= 0xFF51AFD7ED558CCDULL;
+		h ^= h >> 33;
+		return size_t(h & (TABLE_SIZE - 1));
+	}
+
+	/* Attempts to place every key of a bucket using a seed. Does not modify the table if any slot is already taken. */
+	constexpr bool TryPlaceBucket(size_t bucket, unsigned long long seed) {
+		size_t placed[KEY_COUNT] = {};
+		size_t placedCount = 0;
+		for (size_t i = 0; i < KEY_COUNT; i++) {
+			if (BucketOf(hashes[i]) != bucket) continue;
+
+			const size_t slot = SlotOf(hashes[i], seed);
+			if (slots[slot] != NOT_FOUND) return false;
+			for (size_t j = 0; j < placedCount; j++) {
+				if (placed[j] == slot) return false;
+			}
+			placed[placedCount] = slot;
+			placedCount++;
+		}
+
+		placedCount = 0;
+		for (size_t i = 0; i < KEY_COUNT; i++) {
+			if (BucketOf(hashes[i]) != bucket) continue;
+			slots[placed[placedCount]] = int(i);
+			placedCount++;
+		}
+		seeds[bucket] = seed;
+		return true;
+	}
+
+public:
+
+	/* Builds the table at compile time. Duplicate keys fail compilation. */
+	consteval perfect_hash_table(const char* const (&inKeys)[KEY_COUNT])
+		: keys{}, keyLengths{}, hashes{}, seeds{}, slots{}
+	{
+		size_t bucketSizes[BUCKET_COUNT] = {};
+		for (size_t i = 0; i < KEY_COUNT; i++) {
+			keys[i] = inKeys[i];
+			keyLengths[i] = string::StrLen(inKeys[i]);
+			hashes[i] = string::HashChars(keys[i], keyLengths[i]);
+			for (size_t j = 0; j < i; j++) {
+				if (hashes[j] == hashes[i]) {
+					throw "perfect hash table keys must be unique";
+				}
+			}
+			bucketSizes[BucketOf(hashes[i])]++;
+		}
+		for (size_t i = 0; i < TABLE_SIZE; i++) {
+			slots[i] = NOT_FOUND;
+		}
+
+		// Place the largest buckets first, while the table is emptiest.
+		for (size_t size = KEY_COUNT; size > 0; size--) {
+			for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+				if (bucketSizes[bucket] != size) continue;
+
+				unsigned long long seed = 0;
+				while (!TryPlaceBucket(bucket, seed)) {
+					seed++;
+				}
+			}
+		}
+	}
+
+	/* @return Number of keys in the table. */
+	constexpr static size_t Count() { return KEY_COUNT; }
+
+	/* @return The key at an index, in the order they were passed to the constructor. */
+	constexpr const char* KeyAt(size_t index) const { return keys[index]; }
+
+	/* Find the index of a key from its characters and precomputed hash.
+	@return Index of the key in the order they were passed to the constructor, or NOT_FOUND. */
+	[[nodiscard]] constexpr int Find(const char* str, size_t len, unsigned long long hash) const {
+		const int index = slots[SlotOf(hash, seeds[BucketOf(hash)])];
+		if (index == NOT_FOUND) return NOT_FOUND;
+		if (hashes[index] != hash || keyLengths[index] != len) return NOT_FOUND;
+		return string::StrEqual(keys[index], str, len) ? index : NOT_FOUND;
+	}
+
+	/* Find the index of a key.
+	@return Index of the key in the order they were passed to the constructor, or NOT_FOUND. */
+	[[nodiscard]] constexpr int Find(const char* str, size_t len) const {
+		return Find(str, len, string::HashChars(str, len));
+	}
+
+	/* Find the index of a key.
+	@return Index of the key in the order they were passed to the constructor, or NOT_FOUND. */
+	template<size_t BUFFER_SIZE>
+	[[nodiscard]] constexpr int Find(const buffer_string<BUFFER_SIZE>& str) const {
+		return Find(str.CStr(), str.Len(), str.Hash());
+	}
+
+	/* Find the index of a key. Intended for switch case labels, as a key that isn't in the table fails compilation.
+	@return Index of the key in the order they were passed to the constructor. */
+	consteval int IndexOf(const char* key) const {
+		const int index = Find(key, string::StrLen(key));
+		if (index == NOT_FOUND) {
+			throw "key is not in the perfect hash table";
+		}
+		return index;
+	}
+
+};
+
+template<size_t KEY_COUNT>
+perfect_hash_table(const char* const (&)[KEY_COUNT]) -> perfect_hash_table<KEY_COUNT>;
@@ -0,0 +1,81 @@
+#include "string_hash.h"
+
+#define TEST_TYPES "String Hash"
+#include <testframework/unit_test_compile_time.h>
+
+namespace StringHashUnitTests
+{
+
+#pragma region Hash
+
+	constexpr bool HashMatchesLiteral() {
+		string s = "hello world!";
+		return s.Hash() == "hello world!"_hs;
+	}
+	TEST_ASSERT(HashMatchesLiteral(), "String hash does not match the _hs literal of the same characters");
+
+	constexpr bool HashLongMatchesLiteral() {
+		string s = "a string that is long enough to not fit in the sso buffer";
+		return s.Hash() == "a string that is long enough to not fit in the sso buffer"_hs;
+	}
+	TEST_ASSERT(HashLongMatchesLiteral(), "Long string hash does not match the _hs literal of the same characters");
+
+	constexpr bool HashDifferentStrings() {
+		return "hello"_hs != "hellp"_hs;
+	}
+	TEST_ASSERT(HashDifferentStrings(), "Different strings have the same hash");
+
+	constexpr bool HashSwitch() {
+		string s = "stop";
+		switch (s.Hash()) {
+		case "run"_hs: return false;
+		case "stop"_hs: return true;
+		default: return false;
+		}
+	}
+	TEST_ASSERT(HashSwitch(), "Switching on a string hash does not reach the matching case");
+
+#pragma endregion
+
+#pragma region Perfect_Hash_Table
+
+	constexpr perfect_hash_table commands({ "run", "stop", "pause", "resume", "quit", "help", "status", "a command that is much longer than the sso buffer" });
+
+	constexpr bool PerfectHashFindsAllKeys() {
+		for (size_t i = 0; i < commands.Count(); i++) {
+			string key = commands.KeyAt(i);
+			if (commands.Find(key) != int(i)) return false;
+		}
+		return true;
+	}
+	TEST_ASSERT(PerfectHashFindsAllKeys(), "Perfect hash table does not find all of its keys");
+
+	constexpr bool PerfectHashMissingKey() {
+		string s = "runn";
+		return commands.Find(s) == commands.NOT_FOUND && commands.Find("", 0) == commands.NOT_FOUND;
+	}
+	TEST_ASSERT(PerfectHashMissingKey(), "Perfect hash table finds a key that was not added");
+
+	constexpr bool PerfectHashSwitch() {
+		string s = "resume";
+		switch (commands.Find(s)) {
+		case commands.IndexOf("pause"): return false;
+		case commands.IndexOf("resume"): return true;
+		default: return false;
+		}
+	}
+	TEST_ASSERT(PerfectHashSwitch(), "Switching on a perfect hash table index does not reach the matching case");
+
+	constexpr bool PerfectHashManyKeys() {
+		constexpr perfect_hash_table table({ "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p", "q", "r", "s", "t",
+			"u", "v", "w", "x", "y", "z", "aa", "bb", "cc", "dd", "ee", "ff", "gg", "hh", "ii", "jj", "kk", "ll", "mm", "nn" });
+		for (size_t i = 0; i < table.Count(); i++) {
+			if (table.Find(table.KeyAt(i), string::StrLen(table.KeyAt(i))) != int(i)) return false;
+		}
+		return true;
+	}
+	TEST_ASSERT(PerfectHashManyKeys(), "Perfect hash table with many keys does not find all of its keys");
+
+#pragma endregion
+
+}
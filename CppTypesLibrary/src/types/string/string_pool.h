@@ -0,0 +1,284 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <new>
+#include "../../diagnostics/alloc_tracking.h"
+
+/* Set to false before including any string header to make heap strings use new and delete directly instead of string_buffer_pool. */
+#ifndef STRING_BUFFER_POOL
+#define STRING_BUFFER_POOL true
+#endif
+
+/* Reclamation statistics of string_buffer_pool for a single thread. */
+struct string_pool_stats
+{
+	/* Number of buffers handed out from this thread's free lists. */
+	size_t pooledAllocations;
+
+	/* Number of buffers that had to be newly allocated because the free list was empty. */
+	size_t heapAllocations;
+
+	/* Number of buffers this thread freed back onto its own free lists. */
+	size_t localFrees;
+
+	/* Number of buffers owned by other threads that this thread freed, by pushing them onto the owner's remote free list. */
+	size_t remoteFrees;
+
+	/* Number of buffers freed by other threads that this thread moved from its remote free list back onto its free lists. */
+	size_t remoteReclaimed;
+
+	/* Number of buffers deleted because their free list was already full. */
+	size_t trimmedFrees;
+};
+
+/* Per-thread free lists of string heap buffers in the size classes 64, 128, 256 and 512 bytes, for strings just past the sso buffer.
+Buffers remember the thread that allocated them. Freeing one on another thread pushes it onto the owner's lock free remote free list,
+which the owner takes back all at once the next time one of its free lists is empty. When a thread exits its free lists are deleted, and its
+remote free list is adopted by the next new thread, so buffers freed after their owner exits are still reclaimed. Not constexpr valid. */
+struct string_buffer_pool
+{
+	/* Smallest pooled buffer size. */
+	static constexpr size_t SMALLEST_CLASS = 64;
+
+	/* Largest pooled buffer size. Larger buffers use new and delete directly. */
+	static constexpr size_t LARGEST_CLASS = 512;
+
+	static constexpr size_t CLASS_COUNT = 4;
+
+	/* Maximum number of free buffers kept per size class per thread. Anything past this is deleted. */
+	static constexpr size_t MAX_FREE_BUFFERS = 256;
+
+	/* @return The capacity a buffer of at least a number of bytes is allocated with. Pooled sizes round up to their size class. */
+	[[nodiscard]] constexpr static size_t RoundCapacity(size_t bytes) {
+		if (bytes > LARGEST_CLASS) return bytes;
+		return bytes <= SMALLEST_CLASS ? SMALLEST_CLASS : std::bit_ceil(bytes);
+	}
+
+	/* @return The index of the size class of a pooled capacity, from 0 for SMALLEST_CLASS up to CLASS_COUNT - 1 for LARGEST_CLASS.
+	@param capacity: Must be a value returned by RoundCapacity() no larger than LARGEST_CLASS. */
+	[[nodiscard]] constexpr static size_t ClassIndex(size_t capacity) {
+		return size_t(std::countr_zero(capacity)) - size_t(std::countr_zero(SMALLEST_CLASS));
+	}
+
+private:
+
+	struct thread_cache;
+
+	/* Stored directly before every pooled buffer. Keeps the buffer 16 byte aligned. */
+	struct alignas(16) buffer_header
+	{
+		/* Cache of the allocating thread, or nullptr if it was allocated after the thread's cache was destroyed. */
+		thread_cache* owner;
+
+		size_t sizeClass;
+	};
+
+	/* Free buffers are linked through their own first bytes. */
+	struct free_buffer
+	{
+		free_buffer* next;
+	};
+
+	struct thread_cache
+	{
+		free_buffer* freeLists[CLASS_COUNT];
+
+		size_t freeCounts[CLASS_COUNT];
+
+		/* Buffers owned by this cache that other threads have freed. Pushed to by any thread, and emptied by the owner. */
+		std::atomic<free_buffer*> remoteFrees;
+
+		string_pool_stats stats;
+
+		/* Next cache in the list of caches left behind by exited threads. */
+		thread_cache* nextOrphan;
+	};
+
+	/* Trivially destructible per-thread state, so that strings destroyed after the cache owner during thread exit can still check it. */
+	struct thread_state
+	{
+		thread_cache* cache;
+		bool exited;
+	};
+
+	/* Gives the calling thread a cache on construction, and leaves it as an orphan on thread exit. */
+	struct thread_cache_owner
+	{
+		thread_cache* cache;
+
+		thread_cache_owner()
+			: cache(Adopt())
+		{
+			State().cache = cache;
+		}
+
+		~thread_cache_owner() {
+			State().cache = nullptr;
+			State().exited = true;
+			Orphan(cache);
+		}
+	};
+
+	static thread_state& State() {
+		thread_local thread_state state{};
+		return state;
+	}
+
+	/* @return The calling thread's cache, or nullptr if the thread is exiting and its cache was already released. */
+	static thread_cache* LocalCache() {
+		thread_state& state = State();
+		if (state.cache == nullptr && !state.exited) {
+			thread_local thread_cache_owner owner;
+		}
+		return state.cache;
+	}
+
+	static std::mutex& OrphanMutex() {
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	static thread_cache*& Orphans() {
+		static thread_cache* orphans = nullptr;
+		return orphans;
+	}
+
+	/* @return A cache left behind by an exited thread, or a new cache if there are none. Caches are never deleted, so remote frees can always reach them. */
+	static thread_cache* Adopt() {
+		std::lock_guard<std::mutex> lock(OrphanMutex());
+		thread_cache* cache = Orphans();
+		if (cache == nullptr) {
+			cache = new thread_cache{};
+			return cache;
+		}
+		Orphans() = cache->nextOrphan;
+		cache->nextOrphan = nullptr;
+		cache->stats = string_pool_stats{};
+		return cache;
+	}
+
+	/* Deletes every free buffer of an exiting thread's cache, then leaves the cache for a future thread along with its remote free list. */
+	static void Orphan(thread_cache* cache) {
+		for (size_t sizeClass = 0; sizeClass < CLASS_COUNT; sizeClass++) {
+			while (cache->freeLists[sizeClass] != nullptr) {
+				free_buffer* next = cache->freeLists[sizeClass]->next;
+				DeleteBuffer((char*)cache->freeLists[sizeClass]);
+				cache->freeLists[sizeClass] = next;
+			}
+			cache->freeCounts[sizeClass] = 0;
+		}
+		std::lock_guard<std::mutex> lock(OrphanMutex());
+		cache->nextOrphan = Orphans();
+		Orphans() = cache;
+	}
+
+	[[nodiscard]] static buffer_header* HeaderOf(char* buffer) {
+		return (buffer_header*)buffer - 1;
+	}
+
+	[[nodiscard]] static char* NewBuffer(thread_cache* owner, size_t sizeClass) {
+		char* block = new char[sizeof(buffer_header) + (SMALLEST_CLASS << sizeClass)];
+		alloc_tracker<string_buffer_pool>::RecordAllocation(sizeof(buffer_header) + (SMALLEST_CLASS << sizeClass));
+		buffer_header* header = new (block) buffer_header{ owner, sizeClass };
+		return (char*)(header + 1);
+	}
+
+	static void DeleteBuffer(char* buffer) {
+		delete[] (char*)HeaderOf(buffer);
+	}
+
+	/* Puts a buffer on one of the cache's free lists, or deletes it if the list is full. */
+	static void PushFree(thread_cache* cache, char* buffer, size_t sizeClass) {
+		if (cache->freeCounts[sizeClass] == MAX_FREE_BUFFERS) {
+			DeleteBuffer(buffer);
+			cache->stats.trimmedFrees++;
+			return;
+		}
+		free_buffer* node = (free_buffer*)buffer;
+		node->next = cache->freeLists[sizeClass];
+		cache->freeLists[sizeClass] = node;
+		cache->freeCounts[sizeClass]++;
+	}
+
+	/* Takes every buffer other threads have freed back onto the cache's free lists. Exchanging the whole list at once avoids the ABA problem of popping one at a time. */
+	static void ReclaimRemoteFrees(thread_cache* cache) {
+		free_buffer* node = cache->remoteFrees.exchange(nullptr, std::memory_order_acquire);
+		while (node != nullptr) {
+			free_buffer* next = node->next;
+			PushFree(cache, (char*)node, HeaderOf((char*)node)->sizeClass);
+			cache->stats.remoteReclaimed++;
+			node = next;
+		}
+	}
+
+public:
+
+	/* Allocates a string buffer.
+	@param capacity: Must be a value returned by RoundCapacity(). Capacities above LARGEST_CLASS are allocated with new directly. */
+	[[nodiscard]] static char* Allocate(size_t capacity) {
+		if (capacity > LARGEST_CLASS) {
+			return new char[capacity];
+		}
+		const size_t sizeClass = ClassIndex(capacity);
+		thread_cache* cache = LocalCache();
+		if (cache == nullptr) {
+			return NewBuffer(nullptr, sizeClass);
+		}
+		if (cache->freeLists[sizeClass] == nullptr) {
+			ReclaimRemoteFrees(cache);
+		}
+		free_buffer* node = cache->freeLists[sizeClass];
+		if (node == nullptr) {
+			cache->stats.heapAllocations++;
+			return NewBuffer(cache, sizeClass);
+		}
+		cache->freeLists[sizeClass] = node->next;
+		cache->freeCounts[sizeClass]--;
+		cache->stats.pooledAllocations++;
+		return (char*)node;
+	}
+
+	/* Frees a string buffer from any thread.
+	@param capacity: The capacity the buffer was allocated with. */
+	static void Free(char* buffer, size_t capacity) {
+		if (capacity > LARGEST_CLASS) {
+			delete[] buffer;
+			return;
+		}
+		buffer_header* header = HeaderOf(buffer);
+		thread_cache* owner = header->owner;
+		if (owner == nullptr) {
+			DeleteBuffer(buffer);
+			return;
+		}
+		thread_cache* cache = LocalCache();
+		if (owner == cache) {
+			PushFree(cache, buffer, header->sizeClass);
+			cache->stats.localFrees++;
+			return;
+		}
+		free_buffer* node = (free_buffer*)buffer;
+		node->next = owner->remoteFrees.load(std::memory_order_relaxed);
+		while (!owner->remoteFrees.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+		if (cache != nullptr) {
+			cache->stats.remoteFrees++;
+		}
+	}
+
+	/* @return The reclamation statistics of the calling thread. */
+	[[nodiscard]] static string_pool_stats Stats() {
+		thread_cache* cache = LocalCache();
+		return cache == nullptr ? string_pool_stats{} : cache->stats;
+	}
+
+	/* Sets the calling thread's statistics back to 0. */
+	static void ResetStats() {
+		thread_cache* cache = LocalCache();
+		if (cache != nullptr) {
+			cache->stats = string_pool_stats{};
+		}
+	}
+
+};
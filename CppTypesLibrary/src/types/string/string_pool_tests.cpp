@@ -0,0 +1,157 @@
+#include "string_pool.h"
+#include "string.h"
+
+#define TEST_TYPES "String Pool"
+#include <testframework/unit_test_compile_time.h>
+#include <testframework/unit_test_runtime.h>
+
+#include <atomic>
+#include <thread>
+
+namespace StringPoolUnitTests
+{
+
+#pragma region Size_Classes
+
+	TEST_ASSERT(string_buffer_pool::RoundCapacity(1) == 64, "Pool does not round a tiny capacity up to the smallest size class");
+	TEST_ASSERT(string_buffer_pool::RoundCapacity(64) == 64, "Pool does not keep a capacity equal to a size class");
+	TEST_ASSERT(string_buffer_pool::RoundCapacity(65) == 128, "Pool does not round a capacity up to the next size class");
+	TEST_ASSERT(string_buffer_pool::RoundCapacity(512) == 512, "Pool does not keep the largest size class");
+	TEST_ASSERT(string_buffer_pool::RoundCapacity(513) == 513, "Pool rounds a capacity larger than the largest size class");
+
+	TEST_ASSERT(string_buffer_pool::ClassIndex(64) == 0, "Smallest size class is not index 0");
+	TEST_ASSERT(string_buffer_pool::ClassIndex(128) == 1, "128 byte size class is not index 1");
+	TEST_ASSERT(string_buffer_pool::ClassIndex(256) == 2, "256 byte size class is not index 2");
+	TEST_ASSERT(string_buffer_pool::ClassIndex(512) == 3, "Largest size class is not index 3");
+	TEST_ASSERT(string_buffer_pool::ClassIndex(string_buffer_pool::LARGEST_CLASS) == string_buffer_pool::CLASS_COUNT - 1, "Largest size class is not the last class index");
+
+#pragma endregion
+
+#pragma region Allocate_Data
+
+	/* The pool is never used during constant evaluation, so the capacity is exactly the length and null terminator. */
+	constexpr bool ConstexprCapacityUnrounded() {
+		char chars[41];
+		for (int i = 0; i < 40; i++) {
+			chars[i] = 'a';
+		}
+		chars[40] = '\0';
+		string str = chars;
+		string copy = str;
+		return !str.IsSSO() && str.Capacity() == 41 && copy.Capacity() == 41;
+	}
+	TEST_ASSERT(ConstexprCapacityUnrounded(), "Constexpr heap string capacity is not its length plus the null terminator");
+
+	/* At runtime AllocateData() rounds the capacity to the size class, and FreeData() hands that same capacity back to the pool. */
+	bool RuntimeCapacityRounded() {
+		char pooledChars[41];
+		char largeChars[601];
+		for (int i = 0; i < 600; i++) {
+			largeChars[i] = 'a';
+			if (i < 40) pooledChars[i] = 'a';
+		}
+		pooledChars[40] = '\0';
+		largeChars[600] = '\0';
+		string pooled = pooledChars;
+		string large = largeChars;
+		string pooledCopy = pooled;
+		pooled = large;
+		return pooledCopy.Capacity() == (STRING_BUFFER_POOL ? 64 : 41) && large.Capacity() == 601 && pooled.Capacity() == 601 && pooled == large;
+	}
+	RUNTIME_TEST_ASSERT(RuntimeCapacityRounded(), "Runtime heap string capacity is not rounded to its pool size class");
+
+#pragma endregion
+
+#pragma region Local
+
+	bool LocalFreeReused() {
+		string_buffer_pool::ResetStats();
+		char* buffer = string_buffer_pool::Allocate(64);
+		string_buffer_pool::Free(buffer, 64);
+		const string_pool_stats freed = string_buffer_pool::Stats();
+		char* reused = string_buffer_pool::Allocate(64);
+		const string_pool_stats stats = string_buffer_pool::Stats();
+		string_buffer_pool::Free(reused, 64);
+		return reused == buffer && freed.localFrees == 1 && stats.pooledAllocations == freed.pooledAllocations + 1 && stats.remoteFrees == 0;
+	}
+	RUNTIME_TEST_ASSERT(LocalFreeReused(), "Pool does not reuse a buffer freed on the same thread");
+
+	bool LargeBypassesPool() {
+		string_buffer_pool::ResetStats();
+		char* buffer = string_buffer_pool::Allocate(1024);
+		buffer[1023] = 'a';
+		string_buffer_pool::Free(buffer, 1024);
+		const string_pool_stats stats = string_buffer_pool::Stats();
+		return stats.pooledAllocations == 0 && stats.heapAllocations == 0 && stats.localFrees == 0;
+	}
+	RUNTIME_TEST_ASSERT(LargeBypassesPool(), "Pool keeps a buffer larger than its largest size class");
+
+#pragma endregion
+
+#pragma region Cross_Thread
+
+	/* Allocates from a size class until a specific buffer comes back, which reclaims any remote frees along the way, then frees everything allocated.
+	@return If the buffer was allocated again. */
+	bool AllocateUntil(char* buffer, size_t capacity) {
+		char* allocated[string_buffer_pool::MAX_FREE_BUFFERS * 2];
+		size_t count = 0;
+		bool found = false;
+		while (!found && count < string_buffer_pool::MAX_FREE_BUFFERS * 2) {
+			allocated[count] = string_buffer_pool::Allocate(capacity);
+			found = allocated[count] == buffer;
+			count++;
+		}
+		for (size_t i = 0; i < count; i++) {
+			string_buffer_pool::Free(allocated[i], capacity);
+		}
+		return found;
+	}
+
+	/* A buffer freed on another thread goes onto the owner's remote free list, and the owner takes it back once its free list is empty. */
+	bool RemoteFreeReclaimed() {
+		std::atomic<char*> buffer = nullptr;
+		std::atomic<bool> freed = false;
+		bool reclaimed = false;
+		std::thread owner([&]() {
+			buffer = string_buffer_pool::Allocate(128);
+			while (!freed) {
+				std::this_thread::yield();
+			}
+			string_buffer_pool::ResetStats();
+			reclaimed = AllocateUntil(buffer, 128) && string_buffer_pool::Stats().remoteReclaimed >= 1;
+		});
+		while (buffer == nullptr) {
+			std::this_thread::yield();
+		}
+		string_buffer_pool::ResetStats();
+		string_buffer_pool::Free(buffer, 128);
+		const string_pool_stats stats = string_buffer_pool::Stats();
+		freed = true;
+		owner.join();
+		return reclaimed && stats.remoteFrees == 1 && stats.localFrees == 0;
+	}
+	RUNTIME_TEST_ASSERT(RemoteFreeReclaimed(), "Buffer freed on another thread is not reclaimed by its owner");
+
+	/* A buffer freed after its owner exited goes onto the orphaned cache's remote free list, which the next new thread adopts. */
+	bool OrphanAdopted() {
+		// Gives this thread its cache first, otherwise it would adopt the exited thread's cache itself and free the buffer locally.
+		string_buffer_pool::ResetStats();
+		char* buffer = nullptr;
+		std::thread exited([&]() {
+			buffer = string_buffer_pool::Allocate(256);
+		});
+		exited.join();
+		string_buffer_pool::Free(buffer, 256);
+		const string_pool_stats stats = string_buffer_pool::Stats();
+		bool reclaimed = false;
+		std::thread adopter([&]() {
+			reclaimed = AllocateUntil(buffer, 256) && string_buffer_pool::Stats().remoteReclaimed >= 1;
+		});
+		adopter.join();
+		return reclaimed && stats.remoteFrees == 1;
+	}
+	RUNTIME_TEST_ASSERT(OrphanAdopted(), "Buffer freed after its owning thread exited is not reclaimed by the thread adopting its cache");
+
+#pragma endregion
+
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <type_traits>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* Character kernels shared by the string types. Every function is constexpr valid through a scalar path,
+and processes 32 bytes per step with AVX2 at runtime when compiled with it enabled. The sso buffer is aligned to 32 bytes, so small strings are a single aligned block. */
+struct string_simd
+{
+	[[nodiscard]] constexpr static char ToLowerChar(char c) {
+		return (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c;
+	}
+
+	[[nodiscard]] constexpr static char ToUpperChar(char c) {
+		return (c >= 'a' && c <= 'z') ? char(c - ('a' - 'A')) : c;
+	}
+
+#if defined(__AVX2__)
+
+	/* Flips the case bit of every byte within [first, last]. Bytes above 0x7F are negative as signed, so never in range. */
+	[[nodiscard]] static __m256i FlipCaseInRange(__m256i chars, char first, char last) {
+		const __m256i aboveFirst = _mm256_cmpgt_epi8(chars, _mm256_set1_epi8(char(first - 1)));
+		const __m256i belowLast = _mm256_cmpgt_epi8(_mm256_set1_epi8(char(last + 1)), chars);
+		const __m256i inRange = _mm256_and_si256(aboveFirst, belowLast);
+		return _mm256_xor_si256(chars, _mm256_and_si256(inRange, _mm256_set1_epi8(0x20)));
+	}
+
+	[[nodiscard]] static __m256i ToLowerBlock(__m256i chars) {
+		return FlipCaseInRange(chars, 'A', 'Z');
+	}
+
+#endif
+
+	/* Converts ASCII upper case characters to lower case in place. */
+	constexpr static void ToLower(char* str, size_t len) {
+		size_t i = 0;
+#if defined(__AVX2__)
+		if (!std::is_constant_evaluated()) {
+			for (; i + 32 <= len; i += 32) {
+				const __m256i chars = _mm256_loadu_si256((const __m256i*)(str + i));
+				_mm256_storeu_si256((__m256i*)(str + i), FlipCaseInRange(chars, 'A', 'Z'));
+			}
+		}
+#endif
+		for (; i < len; i++) {
+			str[i] = ToLowerChar(str[i]);
+		}
+	}
+
+	/* Converts ASCII lower case characters to upper case in place. */
+	constexpr static void ToUpper(char* str, size_t len) {
+		size_t i = 0;
+#if defined(__AVX2__)
+		if (!std::is_constant_evaluated()) {
+			for (; i + 32 <= len; i += 32) {
+				const __m256i chars = _mm256_loadu_si256((const __m256i*)(str + i));
+				_mm256_storeu_si256((__m256i*)(str + i), FlipCaseInRange(chars, 'a', 'z'));
+			}
+		}
+#endif
+		for (; i < len; i++) {
+			str[i] = ToUpperChar(str[i]);
+		}
+	}
+
+	/* Compares two character arrays of equal length, ignoring ASCII case.
+	@return Negative if str1 orders first, positive if str2 orders first, or 0 if they are equal ignoring case. */
+	[[nodiscard]] constexpr static int CompareIgnoreCase(const char* str1, const char* str2, size_t num) {
+		size_t i = 0;
+#if defined(__AVX2__)
+		if (!std::is_constant_evaluated()) {
+			for (; i + 32 <= num; i += 32) {
+				const __m256i lower1 = ToLowerBlock(_mm256_loadu_si256((const __m256i*)(str1 + i)));
+				const __m256i lower2 = ToLowerBlock(_mm256_loadu_si256((const __m256i*)(str2 + i)));
+				const unsigned int equal = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lower1, lower2));
+				if (equal != 0xFFFFFFFF) {
+					i += (size_t)std::countr_one(equal);
+					return int((unsigned char)ToLowerChar(str1[i])) - int((unsigned char)ToLowerChar(str2[i]));
+				}
+			}
+		}
+#endif
+		for (; i < num; i++) {
+			const unsigned char c1 = (unsigned char)ToLowerChar(str1[i]);
+			const unsigned char c2 = (unsigned char)ToLowerChar(str2[i]);
+			if (c1 != c2) {
+				return int(c1) - int(c2);
+			}
+		}
+		return 0;
+	}
+
+	/* Find the first index at which two character arrays differ, comparing 32 bytes per step.
+	@return Index of the first differing character, or num if they are equal. */
+	[[nodiscard]] constexpr static size_t FindMismatch(const char* str1, const char* str2, size_t num) {
+		size_t i = 0;
+#if defined(__AVX2__)
+		if (!std::is_constant_evaluated()) {
+			for (; i + 32 <= num; i += 32) {
+				const __m256i chars1 = _mm256_loadu_si256((const __m256i*)(str1 + i));
+				const __m256i chars2 = _mm256_loadu_si256((const __m256i*)(str2 + i));
+				const unsigned int equal = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars1, chars2));
+				if (equal != 0xFFFFFFFF) {
+					return i + (size_t)std::countr_one(equal);
+				}
+			}
+		}
+#endif
+		for (; i < num; i++) {
+			if (str1[i] != str2[i]) {
+				return i;
+			}
+		}
+		return num;
+	}
+
+	/* Classify up to 32 characters against a set of delimiter characters in a single pass.
+	@return Bitmask where bit i is set if str[i] is one of the delimiters. Only the first min(len, 32) bits can be set. */
+	[[nodiscard]] constexpr static unsigned int DelimiterMask(const char* str, size_t len, const char* delimiters, size_t delimiterCount) {
+#if defined(__AVX2__)
+		if (!std::is_constant_evaluated() && len >= 32) {
+			const __m256i chars = _mm256_loadu_si256((const __m256i*)str);
+			__m256i matches = _mm256_setzero_si256();
+			for (size_t d = 0; d < delimiterCount; d++) {
+				matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(delimiters[d])));
+			}
+			return (unsigned int)_mm256_movemask_epi8(matches);
+		}
+#endif
+		const size_t count = len < 32 ? len : 32;
+		unsigned int mask = 0;
+		for (size_t i = 0; i < count; i++) {
+			for (size_t d = 0; d < delimiterCount; d++) {
+				if (str[i] == delimiters[d]) {
+					mask |= 1U << i;
+					break;
+				}
+			}
+		}
+		return mask;
+	}
+
+	/* Get the first 8 characters as a big endian integer, padded with zeros. Comparing two prefix keys orders the same as comparing
+	the first 8 characters lexicographically as unsigned bytes, so most comparisons finish with a single integer compare. */
+	[[nodiscard]] constexpr static unsigned long long PrefixKey(const char* str, size_t len) {
+		const size_t count = len < 8 ? len : 8;
+		unsigned long long key = 0;
+		for (size_t i = 0; i < count; i++) {
+			key |= (unsigned long long)(unsigned char)str[i] << (56 - i * 8);
+		}
+		return key;
+	}
+
+	/* Lexicographically compares two character arrays as unsigned bytes. Compares the prefix keys first, then finds the first mismatch.
+	@return Negative if str1 orders first, positive if str2 orders first, or 0 if they are equal. */
+	[[nodiscard]] constexpr static int Compare(const char* str1, size_t len1, const char* str2, size_t len2) {
+		const unsigned long long key1 = PrefixKey(str1, len1);
+		const unsigned long long key2 = PrefixKey(str2, len2);
+		if (key1 != key2) {
+			return key1 < key2 ? -1 : 1;
+		}
+
+		const size_t len = len1 < len2 ? len1 : len2;
+		const size_t mismatch = FindMismatch(str1, str2, len);
+		if (mismatch != len) {
+			return (unsigned char)str1[mismatch] < (unsigned char)str2[mismatch] ? -1 : 1;
+		}
+		return len1 < len2 ? -1 : (len1 > len2 ? 1 : 0);
+	}
+
+	/* 64 bit FNV-1a hash of a character array. Shared by every string type, so equal characters hash equally regardless of type. */
+	[[nodiscard]] constexpr static unsigned long long Hash(const char* str, size_t len) {
+		unsigned long long hash = 14695981039346656037ULL;
+		for (size_t i = 0; i < len; i++) {
+			hash ^= (unsigned char)str[i];
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
+	/* 64 bit FNV-1a hash of the lower case version of a character array. Equal for any two arrays that are equal ignoring ASCII case. */
+	[[nodiscard]] constexpr static unsigned long long HashIgnoreCase(const char* str, size_t len) {
+		unsigned long long hash = 14695981039346656037ULL;
+		for (size_t i = 0; i < len; i++) {
+			hash ^= (unsigned char)ToLowerChar(str[i]);
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
+};
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "string.h"
+#include "../array/dynamic_array.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+/* Arrays with at least this many strings are split across threads by ParallelStringSort(). */
+constexpr arrint _PARALLEL_STRING_SORT_THRESHOLD = 1 << 20;
+
+/* Cached sort key of a single string. Sorting moves these 24 byte entries around instead of the strings themselves. */
+struct string_sort_entry
+{
+	/* The 8 characters at the current depth as a big endian integer. See string_simd::PrefixKey(). */
+	unsigned long long key;
+
+	const char* str;
+
+	size_t len;
+
+	/* Index of the string in the array being sorted. */
+	arrint index;
+};
+
+/* Multikey quicksort over cached 8 character keys. Strings are only dereferenced when the keys of a partition are all equal,
+to load the next 8 characters, so nearly all comparisons are a single integer compare. */
+struct string_sorter
+{
+	/* Partitions smaller than this are insertion sorted. */
+	static constexpr size_t INSERTION_SORT_THRESHOLD = 16;
+
+	/* Sorts entries[begin, end), all of which share their first depth characters. */
+	constexpr static void Sort(string_sort_entry* entries, size_t begin, size_t end, size_t depth) {
+		while (end - begin > 1) {
+			if (end - begin < INSERTION_SORT_THRESHOLD) {
+				InsertionSort(entries, begin, end, depth);
+				return;
+			}
+
+			const unsigned long long pivot = MedianOfThree(entries[begin].key, entries[begin + (end - begin) / 2].key, entries[end - 1].key);
+
+			// Three way partition into [begin, lt) < pivot, [lt, gt) == pivot, [gt, end) > pivot.
+			size_t lt = begin;
+			size_t gt = end;
+			size_t i = begin;
+			while (i < gt) {
+				if (entries[i].key < pivot) {
+					Swap(entries[lt], entries[i]);
+					lt++;
+					i++;
+				}
+				else if (entries[i].key > pivot) {
+					gt--;
+					Swap(entries[i], entries[gt]);
+				}
+				else {
+					i++;
+				}
+			}
+
+			// Strings that end within these 8 characters come before every string that continues. Their keys are padded with nulls,
+			// so they only differ by how many trailing nulls they have, and the shorter string comes first.
+			size_t ended = lt;
+			for (size_t j = lt; j < gt; j++) {
+				if (entries[j].len <= depth + 8) {
+					Swap(entries[ended], entries[j]);
+					ended++;
+				}
+			}
+			SortByLength(entries, lt, ended, depth);
+
+			const size_t nextDepth = depth + 8;
+			for (size_t j = ended; j < gt; j++) {
+				entries[j].key = string_simd::PrefixKey(entries[j].str + nextDepth, entries[j].len - nextDepth);
+			}
+
+			// Recurse into the two smaller partitions and loop on the largest, so the recursion depth stays logarithmic.
+			const size_t lessCount = lt - begin;
+			const size_t continuingCount = gt - ended;
+			const size_t greaterCount = end - gt;
+			if (continuingCount >= lessCount && continuingCount >= greaterCount) {
+				Sort(entries, begin, lt, depth);
+				Sort(entries, gt, end, depth);
+				begin = ended;
+				end = gt;
+				depth = nextDepth;
+			}
+			else if (lessCount >= greaterCount) {
+				Sort(entries, ended, gt, nextDepth);
+				Sort(entries, gt, end, depth);
+				end = lt;
+			}
+			else {
+				Sort(entries, begin, lt, depth);
+				Sort(entries, ended, gt, nextDepth);
+				begin = gt;
+			}
+		}
+	}
+
+	/* Fills in the entries of an array of strings with their depth 0 keys. */
+	template<size_t BUFFER_SIZE>
+	constexpr static void FillEntries(string_sort_entry* entries, const darray<buffer_string<BUFFER_SIZE>>& arr) {
+		const buffer_string<BUFFER_SIZE>* strings = arr.Data();
+		for (arrint i = 0; i < arr.Size(); i++) {
+			const char* str = strings[i].CStr();
+			const size_t len = strings[i].Len();
+			entries[i] = string_sort_entry{ string_simd::PrefixKey(str, len), str, len, i };
+		}
+	}
+
+	/* Moves the strings into the order of the sorted entries. */
+	template<size_t BUFFER_SIZE>
+	constexpr static void ApplyOrder(const string_sort_entry* entries, darray<buffer_string<BUFFER_SIZE>>& arr) {
+		const arrint count = arr.Size();
+		buffer_string<BUFFER_SIZE>* strings = arr.Data();
+		buffer_string<BUFFER_SIZE>* sorted = new buffer_string<BUFFER_SIZE>[count];
+		for (arrint i = 0; i < count; i++) {
+			sorted[i] = std::move(strings[entries[i].index]);
+		}
+		for (arrint i = 0; i < count; i++) {
+			strings[i] = std::move(sorted[i]);
+		}
+		delete[] sorted;
+	}
+
+private:
+
+	constexpr static void Swap(string_sort_entry& a, string_sort_entry& b) {
+		const string_sort_entry temp = a;
+		a = b;
+		b = temp;
+	}
+
+	constexpr static unsigned long long MedianOfThree(unsigned long long a, unsigned long long b, unsigned long long c) {
+		if (a < b) {
+			if (b < c) return b;
+			return a < c ? c : a;
+		}
+		if (a < c) return a;
+		return b < c ? c : b;
+	}
+
+	/* Orders entries[begin, end), all of which end within the 8 characters after depth, by their length. */
+	constexpr static void SortByLength(string_sort_entry* entries, size_t begin, size_t end, size_t depth) {
+		for (size_t len = depth; len < depth + 8 && end - begin > 1; len++) {
+			for (size_t j = begin; j < end; j++) {
+				if (entries[j].len == len) {
+					Swap(entries[begin], entries[j]);
+					begin++;
+				}
+			}
+		}
+	}
+
+	constexpr static bool EntryLess(const string_sort_entry& a, const string_sort_entry& b, size_t depth) {
+		if (a.key != b.key) {
+			return a.key < b.key;
+		}
+		return string_simd::Compare(a.str + depth, a.len - depth, b.str + depth, b.len - depth) < 0;
+	}
+
+	constexpr static void InsertionSort(string_sort_entry* entries, size_t begin, size_t end, size_t depth) {
+		for (size_t i = begin + 1; i < end; i++) {
+			const string_sort_entry entry = entries[i];
+			size_t j = i;
+			while (j > begin && EntryLess(entry, entries[j - 1], depth)) {
+				entries[j] = entries[j - 1];
+				j--;
+			}
+			entries[j] = entry;
+		}
+	}
+
+};
+
+/* Sorts an array of strings lexicographically (the same order as operator <=>), using multikey quicksort on cached 8 character keys.
+Faster than a comparison sort, which dereferences and compares both strings for every comparison. */
+template<size_t BUFFER_SIZE>
+constexpr void StringSort(darray<buffer_string<BUFFER_SIZE>>& arr) {
+	const arrint count = arr.Size();
+	if (count < 2) return;
+
+	string_sort_entry* entries = new string_sort_entry[count];
+	string_sorter::FillEntries(entries, arr);
+	string_sorter::Sort(entries, 0, count, 0);
+	string_sorter::ApplyOrder(entries, arr);
+	delete[] entries;
+}
+
+/* Sorts an array of strings lexicographically across multiple threads. Strings are first bucketed by their first character,
+then threads take the largest remaining bucket and sort it with multikey quicksort. Arrays smaller than _PARALLEL_STRING_SORT_THRESHOLD
+are sorted on the calling thread. Not constexpr valid.
+@param threadCount: Number of threads to use. 0 uses std::thread::hardware_concurrency(). */
+template<size_t BUFFER_SIZE>
+void ParallelStringSort(darray<buffer_string<BUFFER_SIZE>>& arr, unsigned int threadCount = 0) {
+	if (threadCount == 0) {
+		threadCount = std::thread::hardware_concurrency();
+	}
+	const arrint count = arr.Size();
+	if (count < _PARALLEL_STRING_SORT_THRESHOLD || threadCount < 2) {
+		StringSort(arr);
+		return;
+	}
+
+	string_sort_entry* entries = new string_sort_entry[count];
+	string_sorter::FillEntries(entries, arr);
+
+	// Counting sort on the first character (the top byte of the key) into 256 buckets.
+	size_t bucketStarts[257] = {};
+	for (arrint i = 0; i < count; i++) {
+		bucketStarts[(entries[i].key >> 56) + 1]++;
+	}
+	for (size_t i = 1; i < 257; i++) {
+		bucketStarts[i] += bucketStarts[i - 1];
+	}
+	string_sort_entry* bucketed = new string_sort_entry[count];
+	size_t insertPositions[256];
+	for (size_t i = 0; i < 256; i++) {
+		insertPositions[i] = bucketStarts[i];
+	}
+	for (arrint i = 0; i < count; i++) {
+		bucketed[insertPositions[entries[i].key >> 56]++] = entries[i];
+	}
+	delete[] entries;
+
+	// Largest buckets first, so one huge bucket doesn't start last.
+	size_t order[256];
+	for (size_t i = 0; i < 256; i++) {
+		order[i] = i;
+	}
+	std::sort(order, order + 256, [&bucketStarts](size_t a, size_t b) {
+		return bucketStarts[a + 1] - bucketStarts[a] > bucketStarts[b + 1] - bucketStarts[b];
+	});
+
+	std::atomic<size_t> nextBucket = 0;
+	auto worker = [&]() {
+		for (size_t i = nextBucket++; i < 256; i = nextBucket++) {
+			const size_t bucket = order[i];
+			string_sorter::Sort(bucketed, bucketStarts[bucket], bucketStarts[bucket + 1], 0);
+		}
+	};
+
+	std::thread* threads = new std::thread[threadCount - 1];
+	for (unsigned int i = 0; i < threadCount - 1; i++) {
+		threads[i] = std::thread(worker);
+	}
+	worker();
+	for (unsigned int i = 0; i < threadCount - 1; i++) {
+		threads[i].join();
+	}
+	delete[] threads;
+
+	string_sorter::ApplyOrder(bucketed, arr);
+	delete[] bucketed;
+}
@@ -0,0 +1,101 @@
+#include "string_sort.h"
+#include "string_builder.h"
+
+#define TEST_TYPES "String Sort"
+#include <testframework/unit_test_compile_time.h>
+
+namespace StringSortUnitTests
+{
+
+	constexpr bool IsSorted(darray<string>& arr) {
+		for (arrint i = 1; i < arr.Size(); i++) {
+			if (arr[i - 1] > arr[i]) return false;
+		}
+		return true;
+	}
+
+#pragma region String_Sort
+
+	constexpr bool SortEmpty() {
+		darray<string> arr;
+		StringSort(arr);
+		return arr.Size() == 0;
+	}
+	TEST_ASSERT(SortEmpty(), "Sorting an empty string array fails");
+
+	constexpr bool SortSmall() {
+		darray<string> arr;
+		arr.Add("pear");
+		arr.Add("apple");
+		arr.Add("fig");
+		StringSort(arr);
+		return arr[0] == "apple" && arr[1] == "fig" && arr[2] == "pear";
+	}
+	TEST_ASSERT(SortSmall(), "Sorting a small string array does not order it");
+
+	constexpr bool SortSharedPrefixes() {
+		darray<string> arr;
+		const char* words[] = {
+			"prefix_shared_beyond_eight_z", "prefix_shared_beyond_eight_a", "prefix_s", "prefix_", "prefix_shared",
+			"prefix_shared_beyond_eight", "b", "", "prefix_shared_beyond_eight_m", "a", "prefix_shared_beyond_eight_a",
+			"prefix_sh", "zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz", "prefix_shared_beyond_nine", "prefix_r", "prefix_t",
+			"prefix_shared_beyond_eight_b", "a", "prefix_sharee"
+		};
+		for (const char* word : words) {
+			arr.Add(word);
+		}
+		StringSort(arr);
+		return arr.Size() == 19 && IsSorted(arr) && arr[0] == "" && arr[1] == "a" && arr[2] == "a" && arr[18] == "zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz";
+	}
+	TEST_ASSERT(SortSharedPrefixes(), "Sorting strings with long shared prefixes does not order them");
+
+	constexpr bool SortManyGenerated() {
+		darray<string> arr;
+		unsigned int state = 12345;
+		for (int i = 0; i < 200; i++) {
+			char chars[24];
+			state = state * 1103515245 + 12345;
+			const size_t len = (state >> 16) % 20;
+			for (size_t j = 0; j < len; j++) {
+				state = state * 1103515245 + 12345;
+				chars[j] = char('a' + (state >> 16) % 3);
+			}
+			chars[len] = '\0';
+			arr.Add(chars);
+		}
+		StringSort(arr);
+		return arr.Size() == 200 && IsSorted(arr);
+	}
+	TEST_ASSERT(SortManyGenerated(), "Sorting many generated strings does not order them");
+
+	constexpr bool SortHighBytes() {
+		darray<string> arr;
+		arr.Add("\xC3\xA9t\xC3\xA9");
+		arr.Add("ete");
+		arr.Add("\x7F");
+		StringSort(arr);
+		return arr[0] == "ete" && arr[1] == "\x7F" && arr[2] == "\xC3\xA9t\xC3\xA9";
+	}
+	TEST_ASSERT(SortHighBytes(), "Sorting strings does not order characters above 0x7F as unsigned");
+
+	constexpr bool SortTrailingNulls() {
+		darray<string> arr;
+		for (int i = 0; i < 40; i++) {
+			string_builder builder;
+			builder.Append("ab");
+			for (int j = 0; j < (i * 7) % 5; j++) {
+				builder.Append('\0');
+			}
+			arr.Add(builder.Finish());
+		}
+		StringSort(arr);
+		for (arrint i = 1; i < arr.Size(); i++) {
+			if (arr[i - 1].Len() > arr[i].Len()) return false;
+		}
+		return IsSorted(arr);
+	}
+	TEST_ASSERT(SortTrailingNulls(), "Sorting strings that only differ by trailing nulls does not put the shorter strings first");
+
+#pragma endregion
+
+}
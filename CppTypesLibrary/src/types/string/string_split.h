@@ -0,0 +1,128 @@
+#pragma once
+
+#include "string_simd.h"
+#include <bit>
+#include <iterator>
+#include <string_view>
+
+/* Finds delimiter positions in order, classifying each 32 character block once and then consuming its bitmask. */
+struct string_delimiter_scanner
+{
+	const char* str;
+	size_t len;
+
+	/* Set of delimiter characters, or nullptr to use the single delimiter. */
+	const char* delimiters;
+	size_t delimiterCount;
+	char delimiter;
+
+	/* Start of the block that mask classifies. */
+	size_t blockStart;
+
+	/* Delimiters within the current block that have not been returned yet. */
+	unsigned int mask;
+
+	constexpr string_delimiter_scanner(const char* inStr, size_t inLen, const char* inDelimiters, size_t inDelimiterCount, char inDelimiter)
+		: str(inStr), len(inLen), delimiters(inDelimiters), delimiterCount(inDelimiterCount), delimiter(inDelimiter), blockStart(0), mask(0)
+	{
+		if (len > 0) {
+			mask = string_simd::DelimiterMask(str, len, DelimiterSet(), delimiterCount);
+		}
+	}
+
+	/* Get the index of the next delimiter.
+	@return Index of the delimiter, or len if there are no more. */
+	[[nodiscard]] constexpr size_t Next() {
+		while (mask == 0) {
+			if (blockStart + 32 >= len) {
+				return len;
+			}
+			blockStart += 32;
+			mask = string_simd::DelimiterMask(str + blockStart, len - blockStart, DelimiterSet(), delimiterCount);
+		}
+		const size_t index = blockStart + (size_t)std::countr_zero(mask);
+		mask &= mask - 1;
+		return index;
+	}
+
+private:
+
+	[[nodiscard]] constexpr const char* DelimiterSet() const {
+		return delimiters != nullptr ? delimiters : &delimiter;
+	}
+
+};
+
+/* Iterates the fields between delimiters as non-owning views. Views point into the split string, and are invalidated when it is modified or destroyed. */
+struct string_split_iterator
+{
+	string_delimiter_scanner scanner;
+	size_t fieldStart;
+	size_t fieldEnd;
+
+	/* Skip fields of length 0, so consecutive delimiters count as one. */
+	bool skipEmpty;
+	bool done;
+
+	constexpr string_split_iterator(const string_delimiter_scanner& inScanner, bool inSkipEmpty)
+		: scanner(inScanner), fieldStart(0), fieldEnd(0), skipEmpty(inSkipEmpty), done(false)
+	{
+		fieldEnd = scanner.Next();
+		SkipEmptyFields();
+	}
+
+	[[nodiscard]] constexpr std::string_view operator * () const {
+		return std::string_view(scanner.str + fieldStart, fieldEnd - fieldStart);
+	}
+
+	constexpr string_split_iterator& operator ++ () {
+		if (fieldEnd == scanner.len) {
+			done = true;
+			return *this;
+		}
+		fieldStart = fieldEnd + 1;
+		fieldEnd = scanner.Next();
+		SkipEmptyFields();
+		return *this;
+	}
+
+	[[nodiscard]] constexpr bool operator == (std::default_sentinel_t) const {
+		return done;
+	}
+
+private:
+
+	constexpr void SkipEmptyFields() {
+		if (!skipEmpty) return;
+		while (fieldStart == fieldEnd) {
+			if (fieldEnd == scanner.len) {
+				done = true;
+				return;
+			}
+			fieldStart = fieldEnd + 1;
+			fieldEnd = scanner.Next();
+		}
+	}
+
+};
+
+/* Lazy range of the fields of a string separated by delimiters, for use in range based for loops. Nothing is allocated or copied. */
+struct string_split_range
+{
+	string_delimiter_scanner scanner;
+	bool skipEmpty;
+
+	[[nodiscard]] constexpr string_split_iterator begin() const { return string_split_iterator(scanner, skipEmpty); }
+
+	[[nodiscard]] constexpr std::default_sentinel_t end() const { return std::default_sentinel; }
+
+	/* Get the number of fields. Scans the whole string. */
+	[[nodiscard]] constexpr size_t Count() const {
+		size_t count = 0;
+		for (string_split_iterator it = begin(); it != end(); ++it) {
+			count++;
+		}
+		return count;
+	}
+
+};
@@ -1,3 +1,325 @@
+#include "string.h"
+#include <algorithm>
+
+#define TEST_TYPES "String"
+#include <testframework/unit_test_compile_time.h>
+
+namespace StringUnitTests
+{
+
+#pragma region From_Number
+
+	constexpr bool FromIntegerZero() {
+		string s = string::From(0);
+		return s == "0" && s.IsSSO();
+	}
+	TEST_ASSERT(FromIntegerZero(), "String from integer 0 is incorrect");
+
+	constexpr bool FromIntegerPositive() {
+		return string::From(1234567) == "1234567";
+	}
+	TEST_ASSERT(FromIntegerPositive(), "String from positive integer is incorrect");
+
+	constexpr bool FromIntegerNegative() {
+		return string::From(-98765) == "-98765";
+	}
+	TEST_ASSERT(FromIntegerNegative(), "String from negative integer is incorrect");
+
+	constexpr bool FromIntegerLimits() {
+		const bool min = string::From(std::numeric_limits<long long>::min()) == "-9223372036854775808";
+		const bool max = string::From(std::numeric_limits<unsigned long long>::max()) == "18446744073709551615";
+		return min && max;
+	}
+	TEST_ASSERT(FromIntegerLimits(), "String from integer limits is incorrect");
+
+#pragma endregion
+
+#pragma region Parse
+
+	constexpr bool ParseInteger() {
+		string s = "-123456";
+		return s.Parse<int>() == -123456;
+	}
+	TEST_ASSERT(ParseInteger(), "Parsing a negative integer is incorrect");
+
+	constexpr bool ParseIntegerLimits() {
+		string min = "-9223372036854775808";
+		string max = "18446744073709551615";
+		return min.Parse<long long>() == std::numeric_limits<long long>::min() && max.Parse<unsigned long long>() == std::numeric_limits<unsigned long long>::max();
+	}
+	TEST_ASSERT(ParseIntegerLimits(), "Parsing integer limits is incorrect");
+
+	constexpr bool ParseIntegerRoundTrip() {
+		for (int i = -1000; i < 1000; i += 7) {
+			if (string::From(i).Parse<int>() != i) return false;
+		}
+		return true;
+	}
+	TEST_ASSERT(ParseIntegerRoundTrip(), "Integer From() and Parse() do not round trip");
+
+#pragma endregion
+
+#pragma region Case
+
+	constexpr bool ToLowerSSO() {
+		string s = "Hello WORLD 123!";
+		s.ToLower();
+		return s == "hello world 123!";
+	}
+	TEST_ASSERT(ToLowerSSO(), "ToLower on an sso string is incorrect");
+
+	constexpr bool ToUpperHeap() {
+		string s = "content-type: application/json; charset=utf-8 \xC3\xA9";
+		s.ToUpper();
+		return s == "CONTENT-TYPE: APPLICATION/JSON; CHARSET=UTF-8 \xC3\xA9";
+	}
+	TEST_ASSERT(ToUpperHeap(), "ToUpper on a heap string is incorrect, or modified non ASCII bytes");
+
+	constexpr bool ToLowerEmpty() {
+		string s;
+		s.ToLower();
+		return s == "" && s.Len() == 0;
+	}
+	TEST_ASSERT(ToLowerEmpty(), "ToLower on an empty string is incorrect");
+
+	constexpr bool EqualsIgnoreCase() {
+		string s = "X-Forwarded-For";
+		return s.EqualsIgnoreCase("x-forwarded-for") && s.EqualsIgnoreCase(string("X-FORWARDED-FOR")) && !s.EqualsIgnoreCase("x-forwarded-fo");
+	}
+	TEST_ASSERT(EqualsIgnoreCase(), "EqualsIgnoreCase is incorrect");
+
+	constexpr bool CompareIgnoreCase() {
+		string a = "Apple";
+		string b = "apricot";
+		string c = "APPLE";
+		string d = "apples";
+		return a.CompareIgnoreCase(b) < 0 && b.CompareIgnoreCase(a) > 0 && a.CompareIgnoreCase(c) == 0 && a.CompareIgnoreCase(d) < 0;
+	}
+	TEST_ASSERT(CompareIgnoreCase(), "CompareIgnoreCase ordering is incorrect");
+
+	constexpr bool HashIgnoreCase() {
+		string a = "Accept-Encoding";
+		string b = "ACCEPT-ENCODING";
+		string c = "accept-encoding";
+		return a.HashIgnoreCase() == b.HashIgnoreCase() && a.HashIgnoreCase() == c.Hash();
+	}
+	TEST_ASSERT(HashIgnoreCase(), "HashIgnoreCase is not equal for strings that differ only in case");
+
+#pragma endregion
+
+#pragma region Ordering
+
+	constexpr bool OrderingLess() {
+		string a = "apple";
+		string b = "apricot";
+		return a < b && !(b < a) && a <= b && b > a;
+	}
+	TEST_ASSERT(OrderingLess(), "String ordering of different strings is incorrect");
+
+	constexpr bool OrderingPrefix() {
+		string a = "abcdefgh";
+		string b = "abcdefghi";
+		string c = "abc";
+		return a < b && c < a && (a <=> a) == std::strong_ordering::equal;
+	}
+	TEST_ASSERT(OrderingPrefix(), "String ordering of strings that are prefixes of each other is incorrect");
+
+	constexpr bool OrderingPastPrefixKey() {
+		string a = "a long string that shares its first 8 characters, then differs here: a";
+		string b = "a long string that shares its first 8 characters, then differs here: b";
+		return a < b && b > a && a != b;
+	}
+	TEST_ASSERT(OrderingPastPrefixKey(), "String ordering of long strings that differ after the prefix key is incorrect");
+
+	constexpr bool OrderingUnsigned() {
+		string a = "a\xC3\xA9";
+		string b = "az";
+		return b < a;
+	}
+	TEST_ASSERT(OrderingUnsigned(), "String ordering does not compare characters as unsigned bytes");
+
+	constexpr bool OrderingConstChar() {
+		string a = "banana";
+		return a > "apple" && a < "cherry" && (a <=> "banana") == std::strong_ordering::equal;
+	}
+	TEST_ASSERT(OrderingConstChar(), "String ordering against a const char* is incorrect");
+
+	constexpr bool OrderingSort() {
+		darray<string> arr;
+		arr.Add(string("delta"));
+		arr.Add(string("alpha"));
+		arr.Add(string("a string that is longer than the sso buffer"));
+		arr.Add(string("charlie"));
+		std::sort(arr.Data(), arr.Data() + arr.Size());
+		return arr[0] == "a string that is longer than the sso buffer" && arr[1] == "alpha" && arr[2] == "charlie" && arr[3] == "delta";
+	}
+	TEST_ASSERT(OrderingSort(), "Sorting an array of strings is incorrect");
+
+#pragma endregion
+
+#pragma region Split
+
+	constexpr bool SplitFields() {
+		string s = "a,bb,,ccc";
+		const std::string_view expected[] = { "a", "bb", "", "ccc" };
+		size_t i = 0;
+		for (std::string_view field : s.Split(',')) {
+			if (i >= 4 || field != expected[i]) return false;
+			i++;
+		}
+		return i == 4;
+	}
+	TEST_ASSERT(SplitFields(), "String Split() does not produce the fields between delimiters");
+
+	constexpr bool SplitEdges() {
+		string empty = "";
+		string none = "no delimiter";
+		string edges = ",middle,";
+		return empty.Split(',').Count() == 1 && none.Split(',').Count() == 1 && *none.Split(',').begin() == "no delimiter" && edges.Split(',').Count() == 3;
+	}
+	TEST_ASSERT(SplitEdges(), "String Split() of empty, undelimited, or edge delimited strings is incorrect");
+
+	constexpr bool SplitLong() {
+		string s = "field number one is long,field number two is even longer than that,,3,the final field crosses past the sixty fourth character";
+		size_t i = 0;
+		for (std::string_view field : s.Split(',')) {
+			if (i == 1 && field != "field number two is even longer than that") return false;
+			if (i == 4 && field != "the final field crosses past the sixty fourth character") return false;
+			i++;
+		}
+		return i == 5;
+	}
+	TEST_ASSERT(SplitLong(), "String Split() across multiple 32 character blocks is incorrect");
+
+	constexpr bool TokenizeSkipsEmpty() {
+		string s = "  the quick\tbrown  fox jumps over the lazy dog, again and again\n";
+		const std::string_view expected[] = { "the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog", "again", "and", "again" };
+		size_t i = 0;
+		for (std::string_view token : s.Tokenize(" \t\n,")) {
+			if (i >= 12 || token != expected[i]) return false;
+			i++;
+		}
+		return i == 12;
+	}
+	TEST_ASSERT(TokenizeSkipsEmpty(), "String Tokenize() does not skip empty tokens between delimiters");
+
+	constexpr bool TokenizeOnlyDelimiters() {
+		string s = ",,, ,";
+		string empty = "";
+		return s.Tokenize(", ").Count() == 0 && empty.Tokenize(",").Count() == 0;
+	}
+	TEST_ASSERT(TokenizeOnlyDelimiters(), "String Tokenize() of only delimiters produces tokens");
+
+#pragma endregion
+
+#pragma region Move_Assign
+
+	constexpr bool MoveConstructKeepsCapacity() {
+		string s = "a string that is longer than the sso buffer";
+		const size_t capacity = s.Capacity();
+		const char* chars = s.CStr();
+		string moved = std::move(s);
+		return moved.CStr() == chars && moved.Capacity() == capacity && moved == "a string that is longer than the sso buffer";
+	}
+	TEST_ASSERT(MoveConstructKeepsCapacity(), "Move constructed string does not keep the heap data and its capacity");
+
+	constexpr bool MovedFromIsEmpty() {
+		string heap = "a string that is longer than the sso buffer";
+		string small = "small";
+		string movedHeap = std::move(heap);
+		string movedSmall = std::move(small);
+		return heap.IsEmpty() && heap == "" && heap.CStr()[0] == '\0' && small.IsEmpty() && small == "" && movedSmall == "small";
+	}
+	TEST_ASSERT(MovedFromIsEmpty(), "Moved from string is not a valid empty string");
+
+	constexpr bool AssignReusesData() {
+		string s = "a string that is longer than the sso buffer";
+		const char* chars = s.CStr();
+		s = "another string, but not longer than it";
+		const bool reusedConstChar = s.CStr() == chars && s == "another string, but not longer than it";
+		string other = "short";
+		s = other;
+		return reusedConstChar && s.CStr() == chars && s == "short" && s.Len() == 5;
+	}
+	TEST_ASSERT(AssignReusesData(), "Assigning to a string with large enough heap data does not reuse it");
+
+	constexpr bool AssignGrowsData() {
+		string s = "a string that is longer than the sso buffer";
+		s = "a string that is much, much longer than the sso buffer and the first heap data";
+		string small = "small";
+		small = s;
+		return s == "a string that is much, much longer than the sso buffer and the first heap data" && small == s;
+	}
+	TEST_ASSERT(AssignGrowsData(), "Assigning a longer string than the heap data can hold is incorrect");
+
+	constexpr bool MoveAssignSwapsData() {
+		string s = "a string that is longer than the sso buffer";
+		string other = "some other string that is longer than the sso buffer";
+		const char* ownChars = s.CStr();
+		const char* otherChars = other.CStr();
+		s = std::move(other);
+		const bool took = s.CStr() == otherChars && s == "some other string that is longer than the sso buffer";
+		const bool gave = other.IsEmpty() && other.CStr() == ownChars;
+		other = "refilled without allocating";
+		return took && gave && other.CStr() == ownChars && other == "refilled without allocating";
+	}
+	TEST_ASSERT(MoveAssignSwapsData(), "Move assignment does not give the moved from string the old heap data to reuse");
+
+	constexpr bool SelfAssign() {
+		string s = "a string that is longer than the sso buffer";
+		string& ref = s;
+		s = ref;
+		s = std::move(ref);
+		s = s.CStr() + 2;
+		return s == "string that is longer than the sso buffer";
+	}
+	TEST_ASSERT(SelfAssign(), "Assigning a string to itself is incorrect");
+
+#pragma endregion
+
+#pragma region Const_Segment
+
+	constexpr const char* INTERNED_SYMBOL = "interned symbol that is longer than the sso buffer";
+
+	constexpr bool FromInternedPointsAtSymbol() {
+		const string str = string::FromInterned(INTERNED_SYMBOL, string::StrLen(INTERNED_SYMBOL));
+		return str.CStr() == INTERNED_SYMBOL && str.IsConstSegment() && str.Len() == string::StrLen(INTERNED_SYMBOL) && str.Capacity() == 0;
+	}
+	TEST_ASSERT(FromInternedPointsAtSymbol(), "String FromInterned() does not point at the symbol");
+
+	constexpr bool CopyConstSegmentSharesPointer() {
+		const string str = string::FromInterned(INTERNED_SYMBOL, string::StrLen(INTERNED_SYMBOL));
+		const string copy = str;
+		string assigned = "short";
+		assigned = str;
+		return copy.CStr() == INTERNED_SYMBOL && copy.IsConstSegment() && assigned.CStr() == INTERNED_SYMBOL && assigned.IsConstSegment();
+	}
+	TEST_ASSERT(CopyConstSegmentSharesPointer(), "Copying a const segment string does not share the pointer");
+
+	constexpr bool MoveConstSegmentSharesPointer() {
+		string str = string::FromInterned(INTERNED_SYMBOL, string::StrLen(INTERNED_SYMBOL));
+		const string moved = std::move(str);
+		string assigned = "a string that is long enough to own heap data";
+		string other = string::FromInterned(INTERNED_SYMBOL, string::StrLen(INTERNED_SYMBOL));
+		assigned = std::move(other);
+		return moved.CStr() == INTERNED_SYMBOL && moved.IsConstSegment() && assigned.CStr() == INTERNED_SYMBOL && assigned.IsConstSegment()
+			&& str.Len() == 0 && str.CStr()[0] == '\0' && other.Len() == 0;
+	}
+	TEST_ASSERT(MoveConstSegmentSharesPointer(), "Moving a const segment string does not keep the pointer");
+
+	constexpr bool MutateConstSegmentCopies() {
+		const string str = string::FromInterned(INTERNED_SYMBOL, string::StrLen(INTERNED_SYMBOL));
+		string copy = str;
+		copy.ToUpper();
+		return copy.CStr() != INTERNED_SYMBOL && !copy.IsConstSegment() && copy.CStr()[0] == 'I'
+			&& str.CStr() == INTERNED_SYMBOL && INTERNED_SYMBOL[0] == 'i';
+	}
+	TEST_ASSERT(MutateConstSegmentCopies(), "Modifying a copy of a const segment string does not copy the characters first");
+
+#pragma endregion
+
+}
+
 //#include "string.h"
 //
 //#define TEST_TYPES "String"
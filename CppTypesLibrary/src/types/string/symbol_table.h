@@ -0,0 +1,270 @@
+#pragma once
+
+#include "string.h"
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <new>
+
+#define _SYMBOL_TABLE_CACHE_LINE_SIZE 64
+
+/* Stored in the arena directly before the characters of every symbol, so a symbol pointer alone gives its hash and length. */
+struct symbol_header
+{
+	unsigned long long hash;
+	size_t length;
+};
+
+/* Append only storage for the symbols of one shard. Symbols are never moved or freed until the arena is destroyed. Not thread safe on its own. */
+struct symbol_arena
+{
+	/* Size of each block. Symbols that don't fit in a block get a block of their own. */
+	static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+private:
+
+	darray<char*> blocks;
+	char* cursor;
+	size_t remaining;
+
+public:
+
+	symbol_arena()
+		: blocks(), cursor(nullptr), remaining(0)
+	{}
+
+	symbol_arena(const symbol_arena&) = delete;
+
+	symbol_arena& operator = (const symbol_arena&) = delete;
+
+	~symbol_arena() {
+		for (arrint i = 0; i < blocks.Size(); i++) {
+			delete[] blocks[i];
+		}
+	}
+
+	/* Copies the characters after a header and null terminates them. @return Pointer to the copied characters. */
+	const char* Store(const char* str, size_t len, unsigned long long hash) {
+		// Round up so the next header stays aligned.
+		const size_t required = (sizeof(symbol_header) + len + 1 + alignof(symbol_header) - 1) & ~(alignof(symbol_header) - 1);
+		char* out;
+		if (required > BLOCK_SIZE) {
+			out = new char[required];
+			blocks.Add(out);
+		}
+		else {
+			if (required > remaining) {
+				cursor = new char[BLOCK_SIZE];
+				remaining = BLOCK_SIZE;
+				blocks.Add(cursor);
+			}
+			out = cursor;
+			cursor += required;
+			remaining -= required;
+		}
+		alloc_tracker<symbol_arena>::RecordAllocation(required);
+		symbol_header* header = new (out) symbol_header{ hash, len };
+		char* chars = (char*)(header + 1);
+		std::memcpy(chars, str, len);
+		chars[len] = '\0';
+		return chars;
+	}
+
+};
+
+/* A thread safe set of interned strings. Interning the same characters always returns the same pointer, which stays valid for the lifetime of the table,
+so interned symbols compare equal by pointer. Lookups and hits never lock. Symbols are split across SHARD_COUNT shards by hash, and inserting a new symbol
+only locks its shard. Each shard is an open addressing table of atomic symbol pointers. When a shard grows, the old slot table is kept until the table
+is destroyed rather than freed, so a reader still probing it never touches freed memory, and no hazard pointers or epochs are needed. Not constexpr valid. */
+struct concurrent_symbol_table
+{
+	/* Number of independently locked shards. Must be a power of two. */
+	static constexpr size_t SHARD_COUNT = 64;
+
+	/* Initial number of slots per shard. Must be a power of two. */
+	static constexpr size_t INITIAL_SLOTS = 64;
+
+private:
+
+	static constexpr size_t SHARD_SHIFT = 64 - std::countr_zero(SHARD_COUNT);
+
+	struct slot_table
+	{
+		std::atomic<const char*>* slots;
+		size_t mask;
+
+		explicit slot_table(size_t slotCount)
+			: slots(new std::atomic<const char*>[slotCount]), mask(slotCount - 1)
+		{
+			for (size_t i = 0; i < slotCount; i++) {
+				slots[i].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		~slot_table() {
+			delete[] slots;
+		}
+	};
+
+	struct alignas(_SYMBOL_TABLE_CACHE_LINE_SIZE) shard
+	{
+		/* Current slot table. Replaced with release ordering when the shard grows. */
+		std::atomic<slot_table*> table;
+
+		/* Held to insert into this shard. */
+		std::mutex mutex;
+
+		/* Previous slot tables, kept for readers that loaded them before a grow. */
+		darray<slot_table*> retired;
+
+		symbol_arena arena;
+
+		/* Number of symbols in this shard. Guarded by mutex. */
+		size_t count;
+
+		shard()
+			: table(new slot_table(INITIAL_SLOTS)), mutex(), retired(), arena(), count(0)
+		{}
+
+		~shard() {
+			delete table.load(std::memory_order_relaxed);
+			for (arrint i = 0; i < retired.Size(); i++) {
+				delete retired[i];
+			}
+		}
+	};
+
+	shard shards[SHARD_COUNT];
+
+	std::atomic<size_t> symbolCount;
+
+	/* Finalizer of MurmurHash3, so shard and slot selection use well mixed bits of the FNV-1a string hash. */
+	[[nodiscard]] static unsigned long long Mix(unsigned long long hash) {
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb9fe1a85ec53ULL;
+		hash ^= hash >> 33;
+		return hash;
+	}
+
+	[[nodiscard]] static const symbol_header& HeaderOf(const char* symbol) {
+		return *((const symbol_header*)symbol - 1);
+	}
+
+	/* Probes a slot table for a symbol without locking.
+	@param emptySlot: Set to the index of the first empty slot reached if the symbol is not found.
+	@return The symbol, or nullptr if it is not in the table. */
+	[[nodiscard]] static const char* Probe(const slot_table& table, const char* str, size_t len, unsigned long long hash, size_t& emptySlot) {
+		size_t index = size_t(hash) & table.mask;
+		while (true) {
+			const char* symbol = table.slots[index].load(std::memory_order_acquire);
+			if (symbol == nullptr) {
+				emptySlot = index;
+				return nullptr;
+			}
+			const symbol_header& header = HeaderOf(symbol);
+			if (header.hash == hash && header.length == len && string::StrEqual(symbol, str, len)) {
+				return symbol;
+			}
+			index = (index + 1) & table.mask;
+		}
+	}
+
+	/* Moves every symbol into a slot table of twice the size, then publishes it. Must hold the shard's mutex. */
+	static void Grow(shard& s) {
+		slot_table* old = s.table.load(std::memory_order_relaxed);
+		slot_table* grown = new slot_table((old->mask + 1) * 2);
+		for (size_t i = 0; i <= old->mask; i++) {
+			const char* symbol = old->slots[i].load(std::memory_order_relaxed);
+			if (symbol == nullptr) continue;
+			size_t index = size_t(HeaderOf(symbol).hash) & grown->mask;
+			while (grown->slots[index].load(std::memory_order_relaxed) != nullptr) {
+				index = (index + 1) & grown->mask;
+			}
+			grown->slots[index].store(symbol, std::memory_order_relaxed);
+		}
+		s.table.store(grown, std::memory_order_release);
+		s.retired.Add(old);
+	}
+
+public:
+
+	concurrent_symbol_table()
+		: symbolCount(0)
+	{}
+
+	concurrent_symbol_table(const concurrent_symbol_table&) = delete;
+
+	concurrent_symbol_table& operator = (const concurrent_symbol_table&) = delete;
+
+	/* Get the interned symbol with the same characters, adding it if it isn't in the table yet. Only locks when adding.
+	@return Null terminated characters of the symbol. Valid for the lifetime of the table. */
+	[[nodiscard]] const char* Intern(const char* str, size_t len) {
+		const unsigned long long hash = Mix(string::HashChars(str, len));
+		shard& s = shards[hash >> SHARD_SHIFT];
+		size_t emptySlot;
+		const char* found = Probe(*s.table.load(std::memory_order_acquire), str, len, hash, emptySlot);
+		if (found != nullptr) {
+			return found;
+		}
+
+		std::lock_guard<std::mutex> lock(s.mutex);
+		// Another thread may have added the symbol, or grown the shard, since the unlocked probe.
+		slot_table* table = s.table.load(std::memory_order_relaxed);
+		found = Probe(*table, str, len, hash, emptySlot);
+		if (found != nullptr) {
+			return found;
+		}
+		// Keep the load factor at most 3/4 so probe sequences stay short.
+		if ((s.count + 1) * 4 > (table->mask + 1) * 3) {
+			Grow(s);
+			table = s.table.load(std::memory_order_relaxed);
+			(void)Probe(*table, str, len, hash, emptySlot);
+		}
+		const char* symbol = s.arena.Store(str, len, hash);
+		table->slots[emptySlot].store(symbol, std::memory_order_release);
+		s.count++;
+		symbolCount.fetch_add(1, std::memory_order_relaxed);
+		return symbol;
+	}
+
+	[[nodiscard]] const char* Intern(const char* str) {
+		return Intern(str, string::StrLen(str));
+	}
+
+	template<size_t BUFFER_SIZE>
+	[[nodiscard]] const char* Intern(const buffer_string<BUFFER_SIZE>& str) {
+		return Intern(str.CStr(), str.Len());
+	}
+
+	/* Interns a string, and returns a string pointing at the symbol rather than a copy of it. See buffer_string::FromInterned(). */
+	template<size_t BUFFER_SIZE>
+	[[nodiscard]] buffer_string<BUFFER_SIZE> InternString(const buffer_string<BUFFER_SIZE>& str) {
+		return buffer_string<BUFFER_SIZE>::FromInterned(Intern(str), str.Len());
+	}
+
+	/* Get the interned symbol with the same characters without adding it. Never locks.
+	@return Null terminated characters of the symbol, or nullptr if it has not been interned. */
+	[[nodiscard]] const char* Find(const char* str, size_t len) const {
+		const unsigned long long hash = Mix(string::HashChars(str, len));
+		size_t emptySlot;
+		return Probe(*shards[hash >> SHARD_SHIFT].table.load(std::memory_order_acquire), str, len, hash, emptySlot);
+	}
+
+	template<size_t BUFFER_SIZE>
+	[[nodiscard]] const char* Find(const buffer_string<BUFFER_SIZE>& str) const {
+		return Find(str.CStr(), str.Len());
+	}
+
+	/* Get the length of an interned symbol without scanning its characters. */
+	[[nodiscard]] static size_t SymbolLength(const char* symbol) {
+		return HeaderOf(symbol).length;
+	}
+
+	/* Get the number of interned symbols. Only exact while no thread is interning. */
+	[[nodiscard]] size_t Size() const {
+		return symbolCount.load(std::memory_order_relaxed);
+	}
+
+};
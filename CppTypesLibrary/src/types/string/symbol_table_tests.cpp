@@ -0,0 +1,148 @@
+#include "symbol_table.h"
+
+#define TEST_TYPES "Symbol Table"
+#include <testframework/unit_test_runtime.h>
+
+#include <cstring>
+#include <thread>
+
+/* concurrent_symbol_table is not constexpr valid, so every test runs at runtime. */
+namespace SymbolTableUnitTests
+{
+
+#pragma region Arena
+
+	bool ArenaStoreHeader() {
+		symbol_arena arena;
+		const char* first = arena.Store("abc", 3, 7);
+		const char* second = arena.Store("hello world", 11, 9);
+		const symbol_header& header = *((const symbol_header*)second - 1);
+		return std::strcmp(first, "abc") == 0 && std::strcmp(second, "hello world") == 0 && header.hash == 9 && header.length == 11
+			&& (size_t)second % alignof(symbol_header) == 0 && second > first;
+	}
+	RUNTIME_TEST_ASSERT(ArenaStoreHeader(), "Symbol arena does not store the characters null terminated after an aligned header");
+
+	bool ArenaStoreOversized() {
+		symbol_arena arena;
+		darray<char> chars;
+		char* out = chars.AddUninitialized(symbol_arena::BLOCK_SIZE);
+		for (size_t i = 0; i < symbol_arena::BLOCK_SIZE; i++) {
+			out[i] = char('a' + i % 26);
+		}
+		const char* small = arena.Store("small", 5, 1);
+		const char* large = arena.Store(chars.Data(), symbol_arena::BLOCK_SIZE, 2);
+		const char* after = arena.Store("after", 5, 3);
+		return std::memcmp(large, chars.Data(), symbol_arena::BLOCK_SIZE) == 0 && large[symbol_arena::BLOCK_SIZE] == '\0'
+			&& std::strcmp(small, "small") == 0 && std::strcmp(after, "after") == 0;
+	}
+	RUNTIME_TEST_ASSERT(ArenaStoreOversized(), "Symbol arena does not store a symbol larger than a block in a block of its own");
+
+#pragma endregion
+
+#pragma region Intern_Find
+
+	bool InternIdentity() {
+		concurrent_symbol_table table;
+		char chars[] = "identifier";
+		const char* first = table.Intern("identifier");
+		const char* second = table.Intern(chars);
+		const char* third = table.Intern(string("identifier"));
+		return first == second && second == third && first != chars && std::strcmp(first, "identifier") == 0 && table.Size() == 1;
+	}
+	RUNTIME_TEST_ASSERT(InternIdentity(), "Interning the same characters does not return the same symbol");
+
+	bool InternDistinct() {
+		concurrent_symbol_table table;
+		const char* a = table.Intern("a");
+		const char* b = table.Intern("b");
+		const char* ab = table.Intern("ab");
+		return a != b && a != ab && b != ab && table.Size() == 3;
+	}
+	RUNTIME_TEST_ASSERT(InternDistinct(), "Interning different characters does not return different symbols");
+
+	bool FindInterned() {
+		concurrent_symbol_table table;
+		const char* symbol = table.Intern("symbol");
+		return table.Find("symbol", 6) == symbol && table.Find(string("symbol")) == symbol && table.Find("symbo", 5) == nullptr
+			&& table.Find("other", 5) == nullptr && table.Size() == 1;
+	}
+	RUNTIME_TEST_ASSERT(FindInterned(), "Find() does not return the interned symbol, or returns one that was never interned");
+
+	bool SymbolLengthEmbeddedNull() {
+		concurrent_symbol_table table;
+		const char* withNull = table.Intern("a\0b", 3);
+		const char* prefix = table.Intern("a", 1);
+		const char* empty = table.Intern("", 0);
+		return withNull != prefix && concurrent_symbol_table::SymbolLength(withNull) == 3 && concurrent_symbol_table::SymbolLength(prefix) == 1
+			&& concurrent_symbol_table::SymbolLength(empty) == 0 && empty[0] == '\0' && std::memcmp(withNull, "a\0b", 4) == 0;
+	}
+	RUNTIME_TEST_ASSERT(SymbolLengthEmbeddedNull(), "SymbolLength() is not the interned length, or an embedded null is treated as the end");
+
+	bool InternStringShares() {
+		concurrent_symbol_table table;
+		const string first = table.InternString(string("a string long enough to be on the heap"));
+		const string second = table.InternString(string("a string long enough to be on the heap"));
+		const string copy = first;
+		return first.CStr() == second.CStr() && copy.CStr() == first.CStr() && first.IsConstSegment()
+			&& first == "a string long enough to be on the heap" && first.CStr() == table.Find(first);
+	}
+	RUNTIME_TEST_ASSERT(InternStringShares(), "InternString() does not return a string sharing the symbol's characters");
+
+#pragma endregion
+
+#pragma region Grow
+
+	/* 10000 symbols over 64 shards grows every shard's initial 64 slots at least once, keeping the old tables in the retired list. */
+	bool GrowKeepsSymbols() {
+		constexpr int SYMBOL_COUNT = 10000;
+		concurrent_symbol_table table;
+		darray<const char*> symbols;
+		for (int i = 0; i < SYMBOL_COUNT; i++) {
+			symbols.Add(table.Intern(string::From(i)));
+		}
+		for (int i = 0; i < SYMBOL_COUNT; i++) {
+			const string str = string::From(i);
+			if (table.Find(str) != symbols[i] || table.Intern(str) != symbols[i] || std::strcmp(symbols[i], str.CStr()) != 0) {
+				return false;
+			}
+		}
+		return table.Size() == SYMBOL_COUNT;
+	}
+	RUNTIME_TEST_ASSERT(GrowKeepsSymbols(), "Symbols are lost or duplicated when their shard grows");
+
+#pragma endregion
+
+#pragma region Concurrent
+
+	/* Every thread interns the same symbols starting from a different offset, racing to add them. */
+	bool ConcurrentInternIdentity() {
+		constexpr int THREAD_COUNT = 6;
+		constexpr int SYMBOL_COUNT = 2000;
+		concurrent_symbol_table table;
+		darray<const char*> symbols[THREAD_COUNT];
+		std::thread threads[THREAD_COUNT];
+		for (int t = 0; t < THREAD_COUNT; t++) {
+			symbols[t].AddUninitialized(SYMBOL_COUNT);
+			threads[t] = std::thread([&table, &symbols, t]() {
+				for (int n = 0; n < SYMBOL_COUNT; n++) {
+					const int i = (n + t * (SYMBOL_COUNT / THREAD_COUNT)) % SYMBOL_COUNT;
+					symbols[t][i] = table.Intern(string::From(i));
+				}
+			});
+		}
+		for (int t = 0; t < THREAD_COUNT; t++) {
+			threads[t].join();
+		}
+		for (int i = 0; i < SYMBOL_COUNT; i++) {
+			for (int t = 1; t < THREAD_COUNT; t++) {
+				if (symbols[t][i] != symbols[0][i]) return false;
+			}
+			if (table.Find(string::From(i)) != symbols[0][i]) return false;
+		}
+		return table.Size() == SYMBOL_COUNT;
+	}
+	RUNTIME_TEST_ASSERT(ConcurrentInternIdentity(), "Interning the same characters on multiple threads at once does not return the same symbol");
+
+#pragma endregion
+
+}
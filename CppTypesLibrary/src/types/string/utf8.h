@@ -0,0 +1,343 @@
+#pragma once
+
+#include <type_traits>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* UTF-8 validation, decoding, and encoding kernels used by buffer_string.
+Every function is constexpr valid through a scalar path. At runtime, validation and code point counting use AVX2 when compiled with it enabled. */
+struct utf8
+{
+	/* Returned by DecodeNext() for an invalid sequence. */
+	static constexpr char32_t INVALID = 0xFFFFFFFF;
+
+	/* Code point substituted for invalid sequences when iterating. */
+	static constexpr char32_t REPLACEMENT = 0xFFFD;
+
+	/* Decodes the code point starting at index, and advances index past it.
+	Invalid sequences (overlong, surrogate, too large, truncated) return INVALID and advance index by 1.
+	@return The decoded code point, or INVALID. */
+	[[nodiscard]] constexpr static char32_t DecodeNext(const char* str, size_t len, size_t& index) {
+		const unsigned char lead = (unsigned char)str[index];
+		if (lead < 0x80) {
+			index++;
+			return lead;
+		}
+
+		size_t count;
+		char32_t codepoint;
+		char32_t minimum;
+		if ((lead & 0xE0) == 0xC0) {
+			count = 2;
+			codepoint = lead & 0x1F;
+			minimum = 0x80;
+		}
+		else if ((lead & 0xF0) == 0xE0) {
+			count = 3;
+			codepoint = lead & 0x0F;
+			minimum = 0x800;
+		}
+		else if ((lead & 0xF8) == 0xF0) {
+			count = 4;
+			codepoint = lead & 0x07;
+			minimum = 0x10000;
+		}
+		else {
+			index++;
+			return INVALID;
+		}
+
+		if (len - index < count) {
+			index++;
+			return INVALID;
+		}
+		for (size_t i = 1; i < count; i++) {
+			const unsigned char c = (unsigned char)str[index + i];
+			if ((c & 0xC0) != 0x80) {
+				index++;
+				return INVALID;
+			}
+			codepoint = (codepoint << 6) | (c & 0x3F);
+		}
+		if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+			index++;
+			return INVALID;
+		}
+		index += count;
+		return codepoint;
+	}
+
+	/* @return Number of UTF-8 bytes needed to encode a code point, or 0 if it is not a valid scalar value. */
+	[[nodiscard]] constexpr static size_t EncodedLength(char32_t codepoint) {
+		if (codepoint < 0x80) return 1;
+		if (codepoint < 0x800) return 2;
+		if (codepoint >= 0xD800 && codepoint <= 0xDFFF) return 0;
+		if (codepoint < 0x10000) return 3;
+		if (codepoint <= 0x10FFFF) return 4;
+		return 0;
+	}
+
+	/* Encodes a valid code point as UTF-8.
+	@return Number of bytes written. */
+	constexpr static size_t Encode(char32_t codepoint, char* out) {
+		if (codepoint < 0x80) {
+			out[0] = (char)codepoint;
+			return 1;
+		}
+		if (codepoint < 0x800) {
+			out[0] = (char)(0xC0 | (codepoint >> 6));
+			out[1] = (char)(0x80 | (codepoint & 0x3F));
+			return 2;
+		}
+		if (codepoint < 0x10000) {
+			out[0] = (char)(0xE0 | (codepoint >> 12));
+			out[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+			out[2] = (char)(0x80 | (codepoint & 0x3F));
+			return 3;
+		}
+		out[0] = (char)(0xF0 | (codepoint >> 18));
+		out[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+		out[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+		out[3] = (char)(0x80 | (codepoint & 0x3F));
+		return 4;
+	}
+
+	/* Scalar validation. Skips over 8 byte runs of ASCII at a time. */
+	[[nodiscard]] constexpr static bool IsValidScalar(const char* str, size_t len) {
+		size_t index = 0;
+		while (index < len) {
+			if (index + 8 <= len) {
+				unsigned char combined = 0;
+				for (size_t i = 0; i < 8; i++) {
+					combined |= (unsigned char)str[index + i];
+				}
+				if (combined < 0x80) {
+					index += 8;
+					continue;
+				}
+			}
+			if (DecodeNext(str, len, index) == INVALID) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* Scalar code point count. Assumes valid UTF-8, counting every byte that isn't a continuation byte. */
+	[[nodiscard]] constexpr static size_t CodepointCountScalar(const char* str, size_t len) {
+		size_t count = 0;
+		for (size_t i = 0; i < len; i++) {
+			count += ((unsigned char)str[i] & 0xC0) != 0x80;
+		}
+		return count;
+	}
+
+#if defined(__AVX2__)
+
+	/* Lookup table validation from "Validating UTF-8 In Less Than One Instruction Per Byte" (Keiser, Lemire). Each 32 byte block is
+	classified by the high and low nibbles of the previous byte and the high nibble of the current byte, then checked for the required
+	number of continuation bytes. ASCII blocks skip straight through. */
+	[[nodiscard]] static bool IsValidAVX2(const char* str, size_t len) {
+		constexpr unsigned char TOO_SHORT = 1 << 0;
+		constexpr unsigned char TOO_LONG = 1 << 1;
+		constexpr unsigned char OVERLONG_3 = 1 << 2;
+		constexpr unsigned char TOO_LARGE = 1 << 3;
+		constexpr unsigned char SURROGATE = 1 << 4;
+		constexpr unsigned char OVERLONG_2 = 1 << 5;
+		constexpr unsigned char TOO_LARGE_1000 = 1 << 6;
+		constexpr unsigned char OVERLONG_4 = 1 << 6;
+		constexpr unsigned char TWO_CONTS = 1 << 7;
+		constexpr unsigned char CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+		const __m256i byte1HighTable = _mm256_setr_epi8(
+			TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+			TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+			TOO_SHORT | OVERLONG_2,
+			TOO_SHORT,
+			TOO_SHORT | OVERLONG_3 | SURROGATE,
+			TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+			TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+			TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+			TOO_SHORT | OVERLONG_2,
+			TOO_SHORT,
+			TOO_SHORT | OVERLONG_3 | SURROGATE,
+			TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+
+		const __m256i byte1LowTable = _mm256_setr_epi8(
+			CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+			CARRY | OVERLONG_2,
+			CARRY,
+			CARRY,
+			CARRY | TOO_LARGE,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+			CARRY | OVERLONG_2,
+			CARRY,
+			CARRY,
+			CARRY | TOO_LARGE,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000);
+
+		const __m256i byte2HighTable = _mm256_setr_epi8(
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+
+		// Any of the last 3 bytes of a block being a lead byte means the sequence continues into the next block.
+		const __m256i incompleteMax = _mm256_setr_epi8(
+			-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+		const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+		__m256i error = _mm256_setzero_si256();
+		__m256i previousInput = _mm256_setzero_si256();
+		__m256i previousIncomplete = _mm256_setzero_si256();
+
+		size_t index = 0;
+		alignas(32) char tail[32];
+		while (index < len) {
+			__m256i input;
+			if (len - index >= 32) {
+				input = _mm256_loadu_si256((const __m256i*)(str + index));
+			}
+			else {
+				for (size_t i = 0; i < 32; i++) {
+					tail[i] = index + i < len ? str[index + i] : 0;
+				}
+				input = _mm256_load_si256((const __m256i*)tail);
+			}
+			index += 32;
+
+			if (_mm256_movemask_epi8(input) == 0) {
+				error = _mm256_or_si256(error, previousIncomplete);
+				previousInput = input;
+				previousIncomplete = _mm256_setzero_si256();
+				continue;
+			}
+
+			const __m256i shuffled = _mm256_permute2x128_si256(previousInput, input, 0x21);
+			const __m256i prev1 = _mm256_alignr_epi8(input, shuffled, 16 - 1);
+			const __m256i prev2 = _mm256_alignr_epi8(input, shuffled, 16 - 2);
+			const __m256i prev3 = _mm256_alignr_epi8(input, shuffled, 16 - 3);
+
+			const __m256i byte1High = _mm256_shuffle_epi8(byte1HighTable, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibbleMask));
+			const __m256i byte1Low = _mm256_shuffle_epi8(byte1LowTable, _mm256_and_si256(prev1, nibbleMask));
+			const __m256i byte2High = _mm256_shuffle_epi8(byte2HighTable, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask));
+			const __m256i specialCases = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+			const __m256i isThirdByte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xE0 - 0x80)));
+			const __m256i isFourthByte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+			const __m256i must23 = _mm256_and_si256(_mm256_or_si256(isThirdByte, isFourthByte), _mm256_set1_epi8(char(0x80)));
+
+			error = _mm256_or_si256(error, _mm256_xor_si256(must23, specialCases));
+			previousIncomplete = _mm256_subs_epu8(input, incompleteMax);
+			previousInput = input;
+		}
+		error = _mm256_or_si256(error, previousIncomplete);
+		return _mm256_testz_si256(error, error);
+	}
+
+	/* Counts every byte that isn't a continuation byte, 32 bytes at a time. Assumes valid UTF-8. */
+	[[nodiscard]] static size_t CodepointCountAVX2(const char* str, size_t len) {
+		// Continuation bytes 0x80 - 0xBF are -128 to -65 as signed bytes.
+		const __m256i continuationMax = _mm256_set1_epi8(-65);
+		size_t count = 0;
+		size_t index = 0;
+		for (; index + 32 <= len; index += 32) {
+			const __m256i input = _mm256_loadu_si256((const __m256i*)(str + index));
+			const unsigned int leads = (unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(input, continuationMax));
+			count += (size_t)std::popcount(leads);
+		}
+		return count + CodepointCountScalar(str + index, len - index);
+	}
+
+#endif
+
+	/* @return If the characters are entirely valid UTF-8. Rejects overlong encodings, surrogates, code points above U+10FFFF, and truncated sequences. */
+	[[nodiscard]] constexpr static bool IsValid(const char* str, size_t len) {
+#if defined(__AVX2__)
+		if (!std::is_constant_evaluated()) {
+			return IsValidAVX2(str, len);
+		}
+#endif
+		return IsValidScalar(str, len);
+	}
+
+	/* @return Number of code points in valid UTF-8 characters. */
+	[[nodiscard]] constexpr static size_t CodepointCount(const char* str, size_t len) {
+#if defined(__AVX2__)
+		if (!std::is_constant_evaluated()) {
+			return CodepointCountAVX2(str, len);
+		}
+#endif
+		return CodepointCountScalar(str, len);
+	}
+
+};
+
+/* Iterates the code points of UTF-8 characters. Invalid sequences produce utf8::REPLACEMENT. */
+struct utf8_codepoint_iterator
+{
+	const char* str;
+	size_t len;
+	size_t index;
+
+	[[nodiscard]] constexpr char32_t operator * () const {
+		size_t next = index;
+		const char32_t codepoint = utf8::DecodeNext(str, len, next);
+		return codepoint == utf8::INVALID ? utf8::REPLACEMENT : codepoint;
+	}
+
+	constexpr utf8_codepoint_iterator& operator ++ () {
+		(void)utf8::DecodeNext(str, len, index);
+		return *this;
+	}
+
+	[[nodiscard]] constexpr bool operator == (const utf8_codepoint_iterator& other) const {
+		return index == other.index;
+	}
+
+};
+
+/* Range of the code points of UTF-8 characters, for use in range based for loops. */
+struct utf8_codepoint_range
+{
+	const char* str;
+	size_t len;
+
+	[[nodiscard]] constexpr utf8_codepoint_iterator begin() const { return utf8_codepoint_iterator{ str, len, 0 }; }
+
+	[[nodiscard]] constexpr utf8_codepoint_iterator end() const { return utf8_codepoint_iterator{ str, len, len }; }
+
+};
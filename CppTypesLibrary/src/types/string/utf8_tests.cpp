@@ -0,0 +1,111 @@
+#include "string.h"
+
+#define TEST_TYPES "UTF-8"
+#include <testframework/unit_test_compile_time.h>
+
+namespace Utf8UnitTests
+{
+
+#pragma region Validation
+
+	constexpr bool ValidAscii() {
+		string s = "plain ascii text that is longer than the sso buffer";
+		return s.IsValidUtf8();
+	}
+	TEST_ASSERT(ValidAscii(), "ASCII string is not valid UTF-8");
+
+	constexpr bool ValidMultibyte() {
+		string s = "\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF";
+		return s.IsValidUtf8();
+	}
+	TEST_ASSERT(ValidMultibyte(), "String with 2, 3, and 4 byte sequences is not valid UTF-8");
+
+	constexpr bool InvalidOverlong() {
+		return !string("\xC0\xAF").IsValidUtf8() && !string("\xE0\x80\xAF").IsValidUtf8() && !string("\xF0\x80\x80\xAF").IsValidUtf8();
+	}
+	TEST_ASSERT(InvalidOverlong(), "Overlong encodings are valid UTF-8");
+
+	constexpr bool InvalidSurrogate() {
+		return !string("\xED\xA0\x80").IsValidUtf8();
+	}
+	TEST_ASSERT(InvalidSurrogate(), "Encoded surrogate is valid UTF-8");
+
+	constexpr bool InvalidTooLarge() {
+		return !string("\xF4\x90\x80\x80").IsValidUtf8() && !string("\xF8\x88\x80\x80\x80").IsValidUtf8();
+	}
+	TEST_ASSERT(InvalidTooLarge(), "Code point above U+10FFFF is valid UTF-8");
+
+	constexpr bool InvalidTruncated() {
+		return !string("abc\xE2\x82").IsValidUtf8() && !string("\x80").IsValidUtf8();
+	}
+	TEST_ASSERT(InvalidTruncated(), "Truncated sequence or lone continuation byte is valid UTF-8");
+
+#pragma endregion
+
+#pragma region Codepoints
+
+	constexpr bool CodepointCount() {
+		string s = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+		return s.CodepointCount() == 4;
+	}
+	TEST_ASSERT(CodepointCount(), "Code point count is incorrect");
+
+	constexpr bool CodepointIteration() {
+		string s = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+		const char32_t expected[4] = { U'a', 0xE9, 0x20AC, 0x1F600 };
+		size_t i = 0;
+		for (char32_t c : s.Codepoints()) {
+			if (i == 4 || c != expected[i]) return false;
+			i++;
+		}
+		return i == 4;
+	}
+	TEST_ASSERT(CodepointIteration(), "Code point iteration does not decode the correct code points");
+
+	constexpr bool CodepointIterationInvalid() {
+		string s = "a\xFF" "b";
+		const char32_t expected[3] = { U'a', utf8::REPLACEMENT, U'b' };
+		size_t i = 0;
+		for (char32_t c : s.Codepoints()) {
+			if (i == 3 || c != expected[i]) return false;
+			i++;
+		}
+		return i == 3;
+	}
+	TEST_ASSERT(CodepointIterationInvalid(), "Code point iteration does not replace invalid sequences with U+FFFD");
+
+#pragma endregion
+
+#pragma region Transcoding
+
+	constexpr bool ToUtf16SurrogatePair() {
+		string s = "a\xF0\x9F\x98\x80";
+		darray<char16_t> u16 = s.ToUtf16();
+		return u16.Size() == 3 && u16[0] == u'a' && u16[1] == 0xD83D && u16[2] == 0xDE00;
+	}
+	TEST_ASSERT(ToUtf16SurrogatePair(), "UTF-16 transcoding does not produce surrogate pairs correctly");
+
+	constexpr bool Utf16RoundTrip() {
+		string s = "h\xC3\xA9llo w\xE2\x82\xACrld \xF0\x9F\x98\x80 with enough text to leave the sso buffer";
+		darray<char16_t> u16 = s.ToUtf16();
+		return string::FromUtf16(u16.Data(), u16.Size()) == s;
+	}
+	TEST_ASSERT(Utf16RoundTrip(), "UTF-8 to UTF-16 and back does not round trip");
+
+	constexpr bool Utf32RoundTrip() {
+		string s = "h\xC3\xA9llo \xF0\x9F\x98\x80";
+		darray<char32_t> u32 = s.ToUtf32();
+		return u32.Size() == 7 && string::FromUtf32(u32.Data(), u32.Size()) == s;
+	}
+	TEST_ASSERT(Utf32RoundTrip(), "UTF-8 to UTF-32 and back does not round trip");
+
+	constexpr bool FromUtf16IsSSO() {
+		const char16_t chars[3] = { u'a', 0x20AC, u'b' };
+		string s = string::FromUtf16(chars, 3);
+		return s.IsSSO() && s == "a\xE2\x82\xAC" "b";
+	}
+	TEST_ASSERT(FromUtf16IsSSO(), "Small UTF-16 transcoding does not write into the sso buffer");
+
+#pragma endregion
+
+}